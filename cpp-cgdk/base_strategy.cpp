@@ -19,7 +19,10 @@ BaseStrategy::BaseStrategy(const Context& context)
           move_mode_(graph_),
           retreat_mode_(battle_mode_, move_mode_),
           destination_(get_position(context.self())),
-          move_to_position_(context, get_position(context.self()), Target()),
+          tangent_graph_(context.world(), context.game().getWizardRadius() + 1, TANGENT_GRAPH_MAX_EDGE_LENGTH),
+          flow_fields_(graph_, context.game().getMapSize(), context.game().getWizardRadius() + 1),
+          move_to_position_(context, get_position(context.self()), Target(), &path_search_storage_, &tangent_graph_,
+                            &corridor_),
           stats_(*this) {
 }
 
@@ -32,6 +35,10 @@ void BaseStrategy::apply(Context &context) {
     context.check_timeout(__PRETTY_FUNCTION__, __FILE__, __LINE__);
     select_mode(context);
     context.check_timeout(__PRETTY_FUNCTION__, __FILE__, __LINE__);
+    tangent_graph_.update(context.cache());
+    context.check_timeout(__PRETTY_FUNCTION__, __FILE__, __LINE__);
+    flow_fields_.update(context.cache());
+    context.check_timeout(__PRETTY_FUNCTION__, __FILE__, __LINE__);
     apply_mode(context);
     context.check_timeout(__PRETTY_FUNCTION__, __FILE__, __LINE__);
     apply_move(context);
@@ -122,10 +129,13 @@ void BaseStrategy::select_mode(const Context& context) {
 void BaseStrategy::apply_mode(const Context& context) {
     const auto result = mode_->apply(context);
 
+    corridor_ = mode_ == &move_mode_ ? move_mode_.corridor(context) : Corridor();
+
     if (result.active() && (result.destination() != destination_ || result.target() != target_)) {
         target_ = result.target();
         destination_ = result.destination();
-        move_to_position_ = MoveToPosition(context, destination_, target_);
+        move_to_position_ = MoveToPosition(context, destination_, target_, &path_search_storage_, &tangent_graph_, &corridor_,
+                                           flow_fields_.get(destination_));
         return;
     }
 
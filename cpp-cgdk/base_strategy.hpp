@@ -53,6 +53,10 @@ public:
         return move_to_position_.steps_states();
     }
 
+    PathUpdate path_update() const {
+        return move_to_position_.path_update();
+    }
+
     void apply(Context& context) override final;
 
 private:
@@ -63,6 +67,10 @@ private:
     Mode* mode_ = nullptr;
     Target target_;
     Point destination_;
+    PathSearchStorage path_search_storage_;
+    TangentGraph tangent_graph_;
+    FlowFields flow_fields_;
+    Corridor corridor_;
     MoveToPosition move_to_position_;
     model::SkillType skill_from_message_ = model::_SKILL_UNKNOWN_;
     Tick mode_ticks_ = 0;
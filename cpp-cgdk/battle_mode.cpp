@@ -15,13 +15,14 @@ BattleMode::Result BattleMode::apply(const Context& context) {
 }
 
 void BattleMode::reset() {
+    position_warm_starts_.clear();
 }
 
 void BattleMode::update_target(const Context& context) {
     if (is_under_fire(context)) {
         target_ = Target();
         points_.clear();
-        destination_ = {true, this->get_optimal_position(context)};
+        destination_ = {true, this->get_optimal_position(context, PositionCase::UNDER_FIRE)};
         return;
     }
 
@@ -41,7 +42,7 @@ void BattleMode::update_target(const Context& context) {
     if (!destination_.first || will_cast_later(context)) {
         target_ = Target();
         points_.clear();
-        destination_ = {true, this->get_optimal_position(context)};
+        destination_ = {true, this->get_optimal_position(context, PositionCase::NO_TARGET)};
     }
 
     const auto me = make_circle(context.self());
@@ -52,11 +53,20 @@ void BattleMode::update_target(const Context& context) {
                 return unit ? std::min(get_position(*unit).distance(my_position), distance_to_destination) : distance_to_destination;
             })
             : distance_to_destination;
-    const model::Tree* closest_tree_barrier = nullptr;
+    trees_candidates_.clear();
+    trees_candidates_units_.clear();
     for (const auto& tree : context.world().getTrees()) {
-        const auto distance = get_position(tree).distance(my_position);
-        if (closest_distance > distance && make_circle(tree).has_intersection(me, destination_.second)) {
-            closest_tree_barrier = &tree;
+        if (closest_distance > get_position(tree).distance(my_position)) {
+            trees_candidates_.add(make_circle(tree), get_position(tree));
+            trees_candidates_units_.push_back(&tree);
+        }
+    }
+    trees_candidates_.has_intersection(me, destination_.second, trees_intersections_);
+    const model::Tree* closest_tree_barrier = nullptr;
+    for (std::size_t i = 0; i < trees_candidates_units_.size(); ++i) {
+        const auto distance = get_position(*trees_candidates_units_[i]).distance(my_position);
+        if (closest_distance > distance && trees_intersections_[i]) {
+            closest_tree_barrier = trees_candidates_units_[i];
             closest_distance = distance;
         }
     }
@@ -126,30 +136,63 @@ double BattleMode::target_distance(const Context& context) const {
 
 template <class TargetT>
 Point BattleMode::get_optimal_position(const Context& context, const TargetT* target) {
-    return GetOptimalPosition<TargetT>()
+    optimal_position_stats_ = OptimalPositionStats();
+    const auto result = GetOptimalPosition<TargetT>()
             .target(target)
             .max_distance(get_max_distance_for_optimal_position(context))
             .precision(OPTIMAL_POSITION_PRECISION)
             .max_function_calls(OPTIMAL_POSITION_MINIMIZE_MAX_FUNCTION_CALLS)
+            .raster_size(OPTIMAL_POSITION_RASTER_SIZE)
+            .refined_cells(OPTIMAL_POSITION_REFINED_CELLS)
+            .stats(&optimal_position_stats_)
+#ifdef ELSID_STRATEGY_THREADS
+            .starts(OPTIMAL_POSITION_STARTS)
+            .thread_pool(&thread_pool_)
+#endif
+            .warm_starts(&position_warm_starts_, PositionKey {PositionCase::TARGET, target->getId()})
 #ifdef ELSID_STRATEGY_DEBUG
             .points(&points_)
 #endif
             (context);
+    log_optimal_position_stats(context);
+    return result;
+}
+
+void BattleMode::log_optimal_position_stats(const Context& context) const {
+    using Ms = std::chrono::duration<double, std::milli>;
+
+    SLOG(context) << "optimal_position"
+        << " raster_function_calls=" << optimal_position_stats_.raster_function_calls
+        << " raster_duration=" << Ms(optimal_position_stats_.raster_duration).count() << "ms"
+        << " refine_function_calls=" << optimal_position_stats_.refine_function_calls
+        << " refine_duration=" << Ms(optimal_position_stats_.refine_duration).count() << "ms"
+        << '\n';
 }
 
 Point BattleMode::get_optimal_position(const Context&, const model::Bonus* target) {
     return get_position(*target);
 }
 
-Point BattleMode::get_optimal_position(const Context& context) {
-    return GetOptimalPosition<model::LivingUnit>()
+Point BattleMode::get_optimal_position(const Context& context, PositionCase type) {
+    optimal_position_stats_ = OptimalPositionStats();
+    const auto result = GetOptimalPosition<model::LivingUnit>()
             .max_distance(get_max_distance_for_optimal_position(context))
             .precision(OPTIMAL_POSITION_PRECISION)
             .max_function_calls(OPTIMAL_POSITION_MINIMIZE_MAX_FUNCTION_CALLS)
+            .raster_size(OPTIMAL_POSITION_RASTER_SIZE)
+            .refined_cells(OPTIMAL_POSITION_REFINED_CELLS)
+            .stats(&optimal_position_stats_)
+#ifdef ELSID_STRATEGY_THREADS
+            .starts(OPTIMAL_POSITION_STARTS)
+            .thread_pool(&thread_pool_)
+#endif
+            .warm_starts(&position_warm_starts_, PositionKey {type, 0})
 #ifdef ELSID_STRATEGY_DEBUG
             .points(&points_)
 #endif
             (context);
+    log_optimal_position_stats(context);
+    return result;
 }
 
 }
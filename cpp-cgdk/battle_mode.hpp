@@ -1,6 +1,8 @@
 #pragma once
 
 #include "mode.hpp"
+#include "moving_circles.hpp"
+#include "optimal_position.hpp"
 
 namespace strategy {
 
@@ -13,22 +15,35 @@ public:
         return points_;
     }
 
+    const OptimalPositionStats& optimal_position_stats() const {
+        return optimal_position_stats_;
+    }
+
     bool is_under_fire(const Context& context) const;
 
 private:
     Target target_;
     std::pair<bool, Point> destination_;
     std::vector<std::pair<Point, double>> points_;
+    OptimalPositionStats optimal_position_stats_;
+    PositionWarmStarts position_warm_starts_;
+    MovingCircles trees_candidates_;
+    std::vector<const model::Tree*> trees_candidates_units_;
+    std::vector<char> trees_intersections_;
+#ifdef ELSID_STRATEGY_THREADS
+    ThreadPool thread_pool_ {OPTIMAL_POSITION_THREADS - 1};
+#endif
 
     void update_target(const Context& context);
     bool will_cast_later(const Context& context) const;
     double target_distance(const Context& context) const;
+    void log_optimal_position_stats(const Context& context) const;
 
     template <class TargetT>
     Point get_optimal_position(const Context& context, const TargetT* target);
 
     Point get_optimal_position(const Context& context, const model::Bonus* target);
-    Point get_optimal_position(const Context& context);
+    Point get_optimal_position(const Context& context, PositionCase type);
 };
 
 }
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace strategy {
+namespace benchmarks {
+
+using Clock = std::chrono::steady_clock;
+
+template <class Function>
+double measure(std::size_t iterations, const Function& function) {
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        function();
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / double(iterations);
+}
+
+void run_moving_circles();
+void run_units_danger();
+
+} // namespace benchmarks
+} // namespace strategy
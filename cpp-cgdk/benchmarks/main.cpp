@@ -0,0 +1,7 @@
+#include "benchmarks.hpp"
+
+int main() {
+    strategy::benchmarks::run_moving_circles();
+    strategy::benchmarks::run_units_danger();
+    return 0;
+}
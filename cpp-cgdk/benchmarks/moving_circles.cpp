@@ -0,0 +1,70 @@
+#include "benchmarks.hpp"
+
+#include <moving_circles.hpp>
+
+#include <iostream>
+#include <random>
+
+namespace strategy {
+namespace benchmarks {
+
+namespace {
+
+void run(std::size_t size, bool moving) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> position(0, 1000);
+    std::uniform_real_distribution<double> radius(5, 50);
+
+    MovingCircles circles;
+    std::vector<std::pair<Circle, Point>> values;
+    circles.reserve(size);
+    values.reserve(size);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        const Circle circle(Point(position(generator), position(generator)), radius(generator));
+        const auto final_position = moving ? Point(position(generator), position(generator)) : circle.position();
+        circles.add(circle, final_position);
+        values.emplace_back(circle, final_position);
+    }
+
+    const Circle me(Point(500, 500), 35);
+    const Point final_position(900, 700);
+    const std::size_t iterations = 1000000 / size + 1;
+    std::vector<char> result;
+    std::size_t scalar_count = 0;
+    std::size_t batch_count = 0;
+
+    const auto scalar = measure(iterations, [&] {
+        for (const auto& value : values) {
+            scalar_count += value.first.has_intersection(value.second, me, final_position);
+        }
+    });
+
+    const auto batch = measure(iterations, [&] {
+        circles.has_intersection(me, final_position, result);
+        for (const auto value : result) {
+            batch_count += value;
+        }
+    });
+
+    std::cout << (moving ? "moving" : "static")
+              << " size=" << size
+              << " scalar=" << scalar << "ns"
+              << " batch=" << batch << "ns"
+              << " speedup=" << scalar / batch
+              << " hits=" << scalar_count / iterations << "/" << batch_count / iterations
+              << '\n';
+}
+
+}
+
+void run_moving_circles() {
+    for (const auto moving : {false, true}) {
+        for (const std::size_t size : {8, 32, 128, 512}) {
+            run(size, moving);
+        }
+    }
+}
+
+} // namespace benchmarks
+} // namespace strategy
@@ -0,0 +1,144 @@
+#include "benchmarks.hpp"
+
+#include <position_penalty_kernels.hpp>
+
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace strategy {
+namespace benchmarks {
+
+namespace {
+
+UnitsDanger make_units_danger(std::size_t size, std::mt19937& generator) {
+    std::uniform_real_distribution<double> position(0, 1000);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> damage(5, 50);
+
+    UnitsDanger result;
+
+    for (std::size_t i = 0; i < 8; ++i) {
+        result.add_friend(Point(position(generator), position(generator)), 35);
+    }
+
+    const auto add = [&] (std::size_t count, bool is_rotating, bool is_minion, bool is_faction_base) {
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto attacks = is_rotating ? 4 : 1;
+            for (int attack = 1; attack <= attacks; ++attack) {
+                const auto range = 500.0 * attack / attacks;
+                const Damage max_damage(Damage::Physic {damage(generator)}, Damage::Magic {damage(generator)});
+                result.add_attack(UnitsDanger::Attack {
+                    attack == attacks ? std::numeric_limits<double>::max() : range,
+                    range + 35,
+                    max_damage,
+                    range,
+                    max_damage.sum(),
+                });
+            }
+            for (std::size_t j = 0; j < 4; ++j) {
+                result.add_friend_minion_distance(position(generator));
+            }
+            for (std::size_t j = 0; j < 2; ++j) {
+                result.add_friend_wizard_distance(position(generator));
+            }
+            result.add(UnitsDanger::Unit {
+                Point(position(generator), position(generator)), // position
+                is_faction_base ? 100.0 : 35.0, // radius
+                100, // min_safe_distance
+                1, // attack_ability
+                is_rotating, // is_rotating
+                is_minion, // is_minion
+                is_minion ? Point(1, 1) : Point(0, 0), // mean_speed
+                is_faction_base, // is_faction_base
+                is_faction_base ? 1500.0 : 0.0, // spawned_minions_safe_distance
+                angle(generator), // angle
+                M_PI / 30, // max_turn
+            });
+        }
+        result.finish_group();
+    };
+
+    add(size / 4, true, false, false);
+    add(size - size / 4 - 1, false, true, false);
+    add(1, false, false, true);
+
+    return result;
+}
+
+UnitsDanger::Parameters make_parameters() {
+    UnitsDanger::Parameters result;
+    result.my_position = Point(500, 500);
+    result.my_radius = 35;
+    result.my_life = 100;
+    result.my_max_life = 100;
+    result.my_max_speed = 4;
+    result.my_strafe_speed = 3;
+    result.my_hastened_strafe_speed = 4;
+    result.my_hastened_remaining_ticks = 0;
+    result.burning_damage = 0;
+    result.magic_damage_factor = 1;
+    result.magic_damage_reduction = 0;
+    result.reduce_damage_by_friends = true;
+    result.staff_range = 70;
+    result.max_turn_angle = M_PI / 30;
+    result.max_cast_angle = M_PI / 12;
+    result.minions_spawn_corner = Point(4000, 0);
+    return result;
+}
+
+void run(std::size_t size, std::size_t positions) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> position(0, 1000);
+
+    const auto units_danger = make_units_danger(size, generator);
+    const auto parameters = make_parameters();
+
+    std::vector<double> xs;
+    std::vector<double> ys;
+    xs.reserve(positions);
+    ys.reserve(positions);
+
+    for (std::size_t i = 0; i < positions; ++i) {
+        xs.push_back(position(generator));
+        ys.push_back(position(generator));
+    }
+
+    const std::size_t iterations = 1000000 / (size * positions) + 1;
+    std::vector<double> scalar_result(positions);
+    std::vector<double> batch_result(positions);
+
+    const auto scalar = measure(iterations, [&] {
+        for (std::size_t i = 0; i < positions; ++i) {
+            units_danger.get_penalty(&xs[i], &ys[i], parameters, &scalar_result[i], 1);
+        }
+    });
+
+    const auto batch = measure(iterations, [&] {
+        units_danger.get_penalty(xs.data(), ys.data(), parameters, batch_result.data(), positions);
+    });
+
+    std::cout << "units_danger"
+              << " size=" << size
+              << " positions_per_call=" << positions
+              << " scalar=" << scalar << "ns"
+              << " batch=" << batch << "ns"
+              << " speedup=" << scalar / batch
+              << " throughput=" << double(positions) / batch * 1e3 << "/us"
+              << " equal=" << (scalar_result == batch_result)
+              << '\n';
+}
+
+}
+
+void run_units_danger() {
+    for (const std::size_t size : {4, 16, 64}) {
+        for (const std::size_t positions : {1, 16, 64, 257}) {
+            run(size, positions);
+        }
+    }
+}
+
+} // namespace benchmarks
+} // namespace strategy
@@ -0,0 +1,116 @@
+#include "circles_grid.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace strategy {
+
+CirclesGrid::CirclesGrid(std::vector<Circle> circles, double cell_size)
+        : circles_(std::move(circles)), cell_size_(cell_size), stamps_(circles_.size(), 0) {
+    if (circles_.empty()) {
+        return;
+    }
+
+    double min_x = std::numeric_limits<double>::max();
+    double min_y = std::numeric_limits<double>::max();
+    double max_x = -std::numeric_limits<double>::max();
+    double max_y = -std::numeric_limits<double>::max();
+
+    for (const auto& circle : circles_) {
+        min_x = std::min(min_x, circle.position().x() - circle.radius());
+        min_y = std::min(min_y, circle.position().y() - circle.radius());
+        max_x = std::max(max_x, circle.position().x() + circle.radius());
+        max_y = std::max(max_y, circle.position().y() + circle.radius());
+    }
+
+    origin_ = Point(min_x, min_y);
+    width_ = std::size_t(std::floor((max_x - min_x) / cell_size_)) + 1;
+    height_ = std::size_t(std::floor((max_y - min_y) / cell_size_)) + 1;
+    cells_begin_.assign(width_ * height_ + 1, 0);
+
+    const auto for_each_cell = [&] (const Circle& circle, const auto& function) {
+        const auto begin_x = get_column(circle.position().x() - circle.radius());
+        const auto end_x = get_column(circle.position().x() + circle.radius());
+        const auto begin_y = get_row(circle.position().y() - circle.radius());
+        const auto end_y = get_row(circle.position().y() + circle.radius());
+        for (auto y = begin_y; y <= end_y; ++y) {
+            for (auto x = begin_x; x <= end_x; ++x) {
+                function(x + width_ * y);
+            }
+        }
+    };
+
+    for (const auto& circle : circles_) {
+        for_each_cell(circle, [&] (std::size_t cell) { ++cells_begin_[cell + 1]; });
+    }
+
+    std::partial_sum(cells_begin_.begin(), cells_begin_.end(), cells_begin_.begin());
+    items_.resize(cells_begin_.back());
+    auto cells_end = cells_begin_;
+
+    for (std::size_t index = 0; index < circles_.size(); ++index) {
+        for_each_cell(circles_[index], [&] (std::size_t cell) { items_[cells_end[cell]++] = index; });
+    }
+}
+
+void CirclesGrid::find_candidates(const Circle& circle, const Point& final_position, std::vector<std::size_t>& result) const {
+    result.clear();
+
+    if (circles_.empty()) {
+        return;
+    }
+
+    if (++stamp_ == 0) {
+        std::fill(stamps_.begin(), stamps_.end(), 0);
+        stamp_ = 1;
+    }
+
+    const auto& begin = circle.position();
+    const auto radius = circle.radius() + 1;
+    const auto max_distance = radius + cell_size_ * M_SQRT1_2;
+    const auto to_end = final_position - begin;
+    const auto to_end_square = to_end.square();
+
+    const auto distance_to_segment = [&] (const Point& point) {
+        if (to_end_square == 0) {
+            return begin.distance(point);
+        }
+        const auto factor = std::min(1.0, std::max(0.0, (point - begin).dot(to_end) / to_end_square));
+        return (begin + to_end * factor).distance(point);
+    };
+
+    const auto begin_x = get_column(std::min(begin.x(), final_position.x()) - radius);
+    const auto end_x = get_column(std::max(begin.x(), final_position.x()) + radius);
+    const auto begin_y = get_row(std::min(begin.y(), final_position.y()) - radius);
+    const auto end_y = get_row(std::max(begin.y(), final_position.y()) + radius);
+
+    for (auto y = begin_y; y <= end_y; ++y) {
+        for (auto x = begin_x; x <= end_x; ++x) {
+            const Point center(origin_.x() + (x + 0.5) * cell_size_, origin_.y() + (y + 0.5) * cell_size_);
+            if (distance_to_segment(center) > max_distance) {
+                continue;
+            }
+            const auto cell = x + width_ * y;
+            for (auto item = cells_begin_[cell]; item < cells_begin_[cell + 1]; ++item) {
+                const auto index = items_[item];
+                if (stamps_[index] != stamp_) {
+                    stamps_[index] = stamp_;
+                    result.push_back(index);
+                }
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+}
+
+std::size_t CirclesGrid::get_column(double x) const {
+    return std::size_t(std::min(double(width_ - 1), std::max(0.0, std::floor((x - origin_.x()) / cell_size_))));
+}
+
+std::size_t CirclesGrid::get_row(double y) const {
+    return std::size_t(std::min(double(height_ - 1), std::max(0.0, std::floor((y - origin_.y()) / cell_size_))));
+}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "circle.hpp"
+
+#include <vector>
+
+namespace strategy {
+
+class CirclesGrid {
+public:
+    CirclesGrid(std::vector<Circle> circles, double cell_size);
+
+    const std::vector<Circle>& circles() const {
+        return circles_;
+    }
+
+    double cell_size() const {
+        return cell_size_;
+    }
+
+    void find_candidates(const Circle& circle, const Point& final_position, std::vector<std::size_t>& result) const;
+
+private:
+    std::vector<Circle> circles_;
+    double cell_size_;
+    Point origin_;
+    std::size_t width_ = 0;
+    std::size_t height_ = 0;
+    std::vector<std::size_t> cells_begin_;
+    std::vector<std::size_t> items_;
+    mutable std::vector<std::size_t> stamps_;
+    mutable std::size_t stamp_ = 0;
+
+    std::size_t get_column(double x) const;
+    std::size_t get_row(double y) const;
+};
+
+}
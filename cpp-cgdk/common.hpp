@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <type_traits>
 
 #if defined(ELSID_STRATEGY_DEBUG) || defined(ELSID_STRATEGY_DEBUG_LOG)
@@ -43,8 +44,36 @@ inline typename std::enable_if<std::is_same<Lhs, Rhs>::value, bool>::type operat
 constexpr Tick MESSAGE_TICKS = 20000;
 constexpr Tick OPTIMAL_PATH_MAX_TICKS = 100;
 constexpr Tick OPTIMAL_PATH_MAX_ITERATIONS = 1000;
+constexpr double OPTIMAL_PATH_STATIC_BARRIERS_CELL_SIZE = 100;
+constexpr double OPTIMAL_PATH_CORRIDOR_WIDTH = 300;
+constexpr std::size_t CORRIDOR_MAX_SEGMENTS = 3;
+constexpr double OPTIMAL_PATH_ANYTIME_INITIAL_WEIGHT = 2.5;
+constexpr double OPTIMAL_PATH_ANYTIME_WEIGHT_DECREASE = 0.5;
+constexpr double OPTIMAL_PATH_ANYTIME_RESERVE_FACTOR = 2;
+constexpr double OPTIMAL_PATH_ANYTIME_TIME_BUDGET_SHARE = 0.25;
+constexpr double OPTIMAL_PATH_CORRIDOR_TIME_BUDGET_SHARE = 0.5;
+constexpr double OPTIMAL_PATH_REPAIR_MAX_COST_RATIO = 1.2;
+constexpr std::size_t TANGENT_GRAPH_VERTICES_PER_BARRIER = 8;
+constexpr double TANGENT_GRAPH_MAX_EDGE_LENGTH = 400;
+constexpr std::size_t TANGENT_GRAPH_MAX_NEW_BARRIERS_PER_UPDATE = 32;
+constexpr double MOVE_TO_POSITION_MAX_POSITION_ERROR = 1;
+constexpr double MOVE_TO_POSITION_MAX_ANGLE_ERROR = 1e-3;
+constexpr double FLOW_FIELD_CELL_SIZE = 50;
+constexpr std::size_t FLOW_FIELDS_MAX_COUNT = 2;
+constexpr double REACH_TIME_CELL_SIZE = 50;
+constexpr double SAFE_PATHS_DANGER_FACTOR = 10;
+constexpr double MOVE_MODE_SAFE_PATH_MIN_IMPROVEMENT = 0.1;
 constexpr double OPTIMAL_POSITION_PRECISION = 1e-3;
 constexpr long OPTIMAL_POSITION_MINIMIZE_MAX_FUNCTION_CALLS = 1000;
+constexpr std::size_t OPTIMAL_POSITION_RASTER_SIZE = 16;
+constexpr std::size_t OPTIMAL_POSITION_REFINED_CELLS = 3;
+constexpr std::size_t OPTIMAL_POSITION_STARTS = 4;
+constexpr std::size_t OPTIMAL_POSITION_THREADS = 2;
+constexpr Tick OPTIMAL_POSITION_WARM_START_MAX_AGE = 10;
+constexpr double OPTIMAL_POSITION_WARM_START_MAX_SHIFT = 50;
+constexpr double OPTIMAL_POSITION_WARM_START_MIN_TRUST_REGION_RADIUS = 1;
+constexpr double OPTIMAL_POSITION_WARM_START_MAX_TRUST_REGION_RADIUS = 100;
+constexpr std::size_t POSITION_PENALTY_BATCH_SIZE = 64;
 constexpr Tick BATTLE_MODE_TICKS = 2500;
 constexpr Tick TICKS_TO_DEATH_FOR_RETREAT = 150;
 constexpr Tick INACTIVE_TIMEOUT = 100;
@@ -4,16 +4,21 @@
 #include "profiler.hpp"
 #include "cache.hpp"
 #include "common.hpp"
+#include "towers_state.hpp"
+#include "reach_time.hpp"
 
 #include "model/Game.h"
 #include "model/Move.h"
 #include "model/Wizard.h"
 #include "model/World.h"
 
+#include <memory>
 #include <sstream>
 
 namespace strategy {
 
+class NodesInfo;
+
 struct Timeout : std::runtime_error {
     using std::runtime_error::runtime_error;
 };
@@ -77,6 +82,28 @@ public:
         return cached_self_;
     }
 
+    const TowersState& towers_state() const {
+        if (!towers_state_) {
+            towers_state_ = std::make_unique<TowersState>(world_, self_.getFaction(), cache_);
+        }
+        return *towers_state_;
+    }
+
+    const ReachTime& reach_time() const {
+        if (!reach_time_) {
+            reach_time_ = std::make_unique<ReachTime>(self_, game_, cache_);
+        }
+        return *reach_time_;
+    }
+
+    const std::shared_ptr<const NodesInfo>& nodes_info() const {
+        return nodes_info_;
+    }
+
+    void nodes_info(std::shared_ptr<const NodesInfo> value) const {
+        nodes_info_ = std::move(value);
+    }
+
     void check_timeout(const char* function, const char* file, int line) const {
         using Ms = std::chrono::duration<double, std::milli>;
         if (profiler().duration() > time_limit()) {
@@ -97,6 +124,9 @@ private:
     const Profiler& profiler_;
     Duration time_limit_;
     const CachedUnit<model::Wizard>& cached_self_;
+    mutable std::unique_ptr<TowersState> towers_state_;
+    mutable std::unique_ptr<ReachTime> reach_time_;
+    mutable std::shared_ptr<const NodesInfo> nodes_info_;
 };
 
 template <class T>
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "common.hpp"
+#include "line.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace strategy {
+
+class Corridor {
+public:
+    using Segment = std::pair<Point, Point>;
+
+    Corridor(double width = 0) : width_(width) {}
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    double width() const {
+        return width_;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+    void clear() {
+        size_ = 0;
+    }
+
+    void add(const Point& begin, const Point& end) {
+        if (size_ == CORRIDOR_MAX_SEGMENTS) {
+            std::ostringstream error;
+            error << "Corridor has more than " << CORRIDOR_MAX_SEGMENTS << " segments in " << __PRETTY_FUNCTION__
+                  << " at " << __FILE__ << ":" << __LINE__;
+            throw std::logic_error(error.str());
+        }
+        segments_[size_++] = Segment(begin, end);
+    }
+
+    bool contains(const Point& point) const {
+        if (empty()) {
+            return true;
+        }
+        for (std::size_t i = 0; i < size_; ++i) {
+            if (get_distance(Line(segments_[i].first, segments_[i].second), point) <= width_) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool contains(const Point& begin, const Point& end) const {
+        if (empty()) {
+            return true;
+        }
+        std::array<Interval, CORRIDOR_MAX_SEGMENTS> intervals;
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < size_; ++i) {
+            const auto interval = get_interval(segments_[i], begin, end);
+            if (interval.first <= interval.second) {
+                std::size_t position = count++;
+                for (; position > 0 && interval < intervals[position - 1]; --position) {
+                    intervals[position] = intervals[position - 1];
+                }
+                intervals[position] = interval;
+            }
+        }
+        double covered = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (intervals[i].first > covered + 1e-9) {
+                return false;
+            }
+            covered = std::max(covered, intervals[i].second);
+        }
+        return covered >= 1 - 1e-9;
+    }
+
+private:
+    using Interval = std::pair<double, double>;
+
+    double width_;
+    std::array<Segment, CORRIDOR_MAX_SEGMENTS> segments_;
+    std::size_t size_ = 0;
+
+    static double get_distance(const Line& segment, const Point& point) {
+        const auto nearest = segment.nearest(point);
+        if (segment.has_point(nearest)) {
+            return nearest.distance(point);
+        }
+        return std::min(segment.begin().distance(point), segment.end().distance(point));
+    }
+
+    Interval get_interval(const Segment& segment, const Point& begin, const Point& end) const {
+        const auto infinity = std::numeric_limits<double>::max();
+        const auto direction = end - begin;
+        Interval result(1, 0);
+
+        const auto unite = [&] (const Interval& value) {
+            const Interval clipped(std::max(value.first, 0.0), std::min(value.second, 1.0));
+            if (clipped.first <= clipped.second) {
+                result = Interval(std::min(result.first, clipped.first), std::max(result.second, clipped.second));
+            }
+        };
+
+        const auto get_linear = [&] (double offset, double factor, double min, double max) {
+            if (factor == 0) {
+                return min <= offset && offset <= max ? Interval(-infinity, infinity) : Interval(1, 0);
+            }
+            const auto first = (min - offset) / factor;
+            const auto second = (max - offset) / factor;
+            return Interval(std::min(first, second), std::max(first, second));
+        };
+
+        const auto add_disk = [&] (const Point& center) {
+            const auto shift = begin - center;
+            const auto a = direction.dot(direction);
+            const auto b = 2 * direction.dot(shift);
+            const auto c = shift.dot(shift) - width_ * width_;
+            if (a == 0) {
+                unite(c <= 0 ? Interval(0, 1) : Interval(1, 0));
+                return;
+            }
+            const auto discriminant = b * b - 4 * a * c;
+            if (discriminant >= 0) {
+                const auto root = std::sqrt(discriminant);
+                unite(Interval((-b - root) / (2 * a), (-b + root) / (2 * a)));
+            }
+        };
+
+        add_disk(segment.first);
+        add_disk(segment.second);
+
+        const auto axis = segment.second - segment.first;
+        const auto length = axis.norm();
+
+        if (length > 0) {
+            const auto along = axis / length;
+            const auto across = along.left_orhtogonal();
+            const auto shift = begin - segment.first;
+            const auto by_along = get_linear(shift.dot(along), direction.dot(along), 0, length);
+            const auto by_across = get_linear(shift.dot(across), direction.dot(across), -width_, width_);
+            unite(Interval(std::max(by_along.first, by_across.first), std::min(by_along.second, by_across.second)));
+        }
+
+        return result;
+    }
+};
+
+}
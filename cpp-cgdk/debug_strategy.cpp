@@ -115,30 +115,30 @@ void DebugStrategy::visualize_graph(const Context& context) {
     Matrix visualized_arcs(nodes.size(), 0);
     for (const auto& src : nodes) {
         for (const auto& dst : nodes) {
-            if (arcs.get(src.first, dst.first) != std::numeric_limits<double>::max()
-                    && !visualized_arcs.get(src.first, dst.first)) {
-                debug_.line(src.second.position.x(), src.second.position.y(), dst.second.position.x(), dst.second.position.y(), 0xAAAAAA);
-                visualized_arcs.set(src.first, dst.first, 1);
-                visualized_arcs.set(dst.first, src.first, 1);
+            if (arcs.get(src.id, dst.id) != std::numeric_limits<double>::max()
+                    && !visualized_arcs.get(src.id, dst.id)) {
+                debug_.line(src.position.x(), src.position.y(), dst.position.x(), dst.position.y(), 0xAAAAAA);
+                visualized_arcs.set(src.id, dst.id, 1);
+                visualized_arcs.set(dst.id, src.id, 1);
             }
         }
     }
     std::vector<double> scores;
     scores.reserve(nodes.size());
     std::transform(nodes.begin(), nodes.end(), std::back_inserter(scores),
-        [&] (const auto& v) { return get_node_score(v.second); });
+        [&] (const auto& v) { return get_node_score(v); });
     const auto minmax_score = std::minmax_element(scores.begin(), scores.end());
     const auto interval = *minmax_score.second - *minmax_score.first;
     for (const auto& node : nodes) {
-        const auto score = scores[node.first];
+        const auto score = scores[node.id];
         const auto color = get_color((score - *minmax_score.first) / (interval ? interval : 1));
-        debug_.fillCircle(node.second.position.x(), node.second.position.y(), 10, color);
-        debug_.text(node.second.position.x() + 30, node.second.position.y() + 30, std::to_string(node.first).c_str(), 0xAAAAAA);
-        debug_.text(node.second.position.x() + 30, node.second.position.y() - 30, std::to_string(score).c_str(), color);
+        debug_.fillCircle(node.position.x(), node.position.y(), 10, color);
+        debug_.text(node.position.x() + 30, node.position.y() + 30, std::to_string(node.id).c_str(), 0xAAAAAA);
+        debug_.text(node.position.x() + 30, node.position.y() - 30, std::to_string(score).c_str(), color);
         const auto lane_type = std::find_if(LANES_COLORS.begin(), LANES_COLORS.end(),
-            [&] (auto lane) { return base_.graph().lanes_nodes().at(lane.first).count(node.first); });
+            [&] (auto lane) { return base_.graph().lanes_nodes().at(lane.first).count(node.id); });
         if (lane_type != LANES_COLORS.end()) {
-            debug_.circle(node.second.position.x(), node.second.position.y(), 15, lane_type->second);
+            debug_.circle(node.position.x(), node.position.y(), 15, lane_type->second);
         }
     }
     const auto friend_base = nodes.at(base_.graph().friend_base());
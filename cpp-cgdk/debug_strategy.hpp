@@ -125,6 +125,10 @@ private:
             }
         }
 
+        if (penalties.empty()) {
+            return;
+        }
+
         const auto min_max = std::minmax_element(penalties.begin(), penalties.end(),
             [] (const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; });
         const double min = min_max.first->second;
@@ -0,0 +1,144 @@
+#include "dynamic_shortest_paths.hpp"
+#include "indexed_heap.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace strategy {
+
+DynamicShortestPaths::DynamicShortestPaths(const Graph& graph)
+        : graph_(graph),
+          weights_(graph.arcs_count()),
+          arcs_src_(graph.arcs_count()),
+          reverse_offsets_(graph.size() + 1, 0),
+          reverse_arcs_(graph.arcs_count()),
+          lengths_(graph.size(), std::numeric_limits<double>::max()),
+          next_(graph.size(), graph.size()),
+          target_(graph.size()) {
+    for (Node src = 0; src < graph.size(); ++src) {
+        for (auto arc = graph.arcs_begin(src); arc != graph.arcs_end(src); ++arc) {
+            weights_[graph.arc_index(arc)] = arc->weight;
+            arcs_src_[graph.arc_index(arc)] = src;
+            ++reverse_offsets_[arc->dst + 1];
+        }
+    }
+    std::partial_sum(reverse_offsets_.begin(), reverse_offsets_.end(), reverse_offsets_.begin());
+    auto filled = reverse_offsets_;
+    for (std::size_t arc = 0; arc < graph.arcs_count(); ++arc) {
+        reverse_arcs_[filled[graph.arc(arc).dst]++] = arc;
+    }
+}
+
+void DynamicShortestPaths::weight(std::size_t arc, double value) {
+    if (weights_[arc] != value) {
+        weights_[arc] = value;
+        changed_arcs_.push_back(arc);
+    }
+}
+
+void DynamicShortestPaths::reset(Node target) {
+    target_ = target;
+    changed_arcs_.clear();
+    std::fill(lengths_.begin(), lengths_.end(), std::numeric_limits<double>::max());
+    std::fill(next_.begin(), next_.end(), graph_.size());
+    lengths_[target] = 0;
+    std::vector<Node> changed({target});
+    propagate(changed);
+}
+
+void DynamicShortestPaths::update() {
+    if (!has_target()) {
+        changed_arcs_.clear();
+        return;
+    }
+
+    const auto infinity = std::numeric_limits<double>::max();
+    const auto dst = [&] (std::size_t arc) { return graph_.arc(arc).dst; };
+    std::vector<char> affected(graph_.size(), false);
+    std::vector<Node> roots;
+
+    for (const auto arc : changed_arcs_) {
+        const auto src = arcs_src_[arc];
+        if (next_[src] == dst(arc) && lengths_[src] < weights_[arc] + lengths_[dst(arc)] && !affected[src]) {
+            affected[src] = true;
+            roots.push_back(src);
+        }
+    }
+
+    for (std::size_t i = 0; i < roots.size(); ++i) {
+        const auto node = roots[i];
+        for (auto arc = reverse_offsets_[node]; arc < reverse_offsets_[node + 1]; ++arc) {
+            const auto child = arcs_src_[reverse_arcs_[arc]];
+            if (next_[child] == node && !affected[child]) {
+                affected[child] = true;
+                roots.push_back(child);
+            }
+        }
+    }
+
+    for (const auto node : roots) {
+        lengths_[node] = infinity;
+        next_[node] = graph_.size();
+    }
+
+    std::vector<Node> changed;
+
+    const auto relax = [&] (Node src, Node other, double weight) {
+        if (lengths_[other] != infinity && weight + lengths_[other] < lengths_[src]) {
+            changed.push_back(src);
+            lengths_[src] = weight + lengths_[other];
+            next_[src] = other;
+        }
+    };
+
+    for (const auto node : roots) {
+        for (auto arc = graph_.arcs_begin(node); arc != graph_.arcs_end(node); ++arc) {
+            if (!affected[arc->dst]) {
+                relax(node, arc->dst, weights_[graph_.arc_index(arc)]);
+            }
+        }
+    }
+
+    for (const auto arc : changed_arcs_) {
+        relax(arcs_src_[arc], dst(arc), weights_[arc]);
+    }
+
+    changed_arcs_.clear();
+    propagate(changed);
+}
+
+Graph::Path DynamicShortestPaths::path(Node src) const {
+    if (src == target_ || next_[src] == graph_.size()) {
+        return Graph::Path {0, {}};
+    }
+    Graph::Path result {lengths_[src], {src}};
+    for (auto node = src; node != target_; node = next_[node]) {
+        result.nodes.push_back(next_[node]);
+    }
+    return result;
+}
+
+void DynamicShortestPaths::propagate(const std::vector<Node>& changed) {
+    IndexedHeap queue(lengths_);
+    for (const auto node : changed) {
+        queue.push_or_decrease(node);
+    }
+    updated_nodes_count_ = 0;
+    while (!queue.empty()) {
+        const auto node = queue.pop();
+        ++updated_nodes_count_;
+        for (auto i = reverse_offsets_[node]; i < reverse_offsets_[node + 1]; ++i) {
+            const auto arc = reverse_arcs_[i];
+            const auto src = arcs_src_[arc];
+            const auto length = lengths_[node] + weights_[arc];
+            if (length < lengths_[src]) {
+                lengths_[src] = length;
+                next_[src] = node;
+                queue.push_or_decrease(src);
+            }
+        }
+    }
+}
+
+}
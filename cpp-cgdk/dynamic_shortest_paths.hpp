@@ -0,0 +1,59 @@
+#pragma once
+
+#include "graph.hpp"
+
+#include <vector>
+
+namespace strategy {
+
+class DynamicShortestPaths {
+public:
+    using Node = Graph::Node;
+
+    DynamicShortestPaths(const Graph& graph);
+
+    bool has_target() const {
+        return target_ != graph_.size();
+    }
+
+    Node target() const {
+        return target_;
+    }
+
+    double weight(std::size_t arc) const {
+        return weights_[arc];
+    }
+
+    double length(Node src) const {
+        return lengths_[src];
+    }
+
+    Node next(Node src) const {
+        return next_[src];
+    }
+
+    std::size_t updated_nodes_count() const {
+        return updated_nodes_count_;
+    }
+
+    void weight(std::size_t arc, double value);
+    void reset(Node target);
+    void update();
+    Graph::Path path(Node src) const;
+
+private:
+    const Graph& graph_;
+    std::vector<double> weights_;
+    std::vector<Node> arcs_src_;
+    std::vector<std::size_t> reverse_offsets_;
+    std::vector<std::size_t> reverse_arcs_;
+    std::vector<double> lengths_;
+    std::vector<Node> next_;
+    std::vector<std::size_t> changed_arcs_;
+    Node target_;
+    std::size_t updated_nodes_count_ = 0;
+
+    void propagate(const std::vector<Node>& changed);
+};
+
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace strategy {
+
+template <class Key, class Value, class Hash = std::hash<Key>, class Equal = std::equal_to<Key>>
+class FlatHashMap {
+public:
+    using Index = std::uint32_t;
+
+    FlatHashMap(std::size_t capacity = 16) {
+        std::size_t slots = 16;
+        while (slots < 2 * capacity) {
+            slots *= 2;
+        }
+        resize(slots);
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    std::size_t capacity() const {
+        return keys_.size() / 2;
+    }
+
+    const Value* find(const Key& key) const {
+        const auto slot = find_slot(key);
+        return is_used(slot) ? &values_[slot] : nullptr;
+    }
+
+    Value* find(const Key& key) {
+        const auto slot = find_slot(key);
+        return is_used(slot) ? &values_[slot] : nullptr;
+    }
+
+    std::pair<Value*, bool> insert(const Key& key, const Value& value) {
+        auto slot = find_slot(key);
+        if (is_used(slot)) {
+            return {&values_[slot], false};
+        }
+        if (2 * (size_ + 1) > keys_.size()) {
+            resize(2 * keys_.size());
+            slot = find_slot(key);
+        }
+        keys_[slot] = key;
+        values_[slot] = value;
+        generations_[slot] = generation_;
+        ++size_;
+        return {&values_[slot], true};
+    }
+
+    Value& operator [](const Key& key) {
+        return *insert(key, Value()).first;
+    }
+
+    void clear() {
+        size_ = 0;
+        if (++generation_ == 0) {
+            std::fill(generations_.begin(), generations_.end(), 0);
+            generation_ = 1;
+        }
+    }
+
+private:
+    std::vector<Key> keys_;
+    std::vector<Value> values_;
+    std::vector<Index> generations_;
+    Index generation_ = 1;
+    std::size_t size_ = 0;
+    std::size_t mask_ = 0;
+    int shift_ = 0;
+
+    bool is_used(std::size_t slot) const {
+        return generations_[slot] == generation_;
+    }
+
+    std::size_t find_slot(const Key& key) const {
+        auto slot = std::size_t((std::uint64_t(Hash()(key)) * 0x9E3779B97F4A7C15ull) >> shift_);
+        while (is_used(slot) && !Equal()(keys_[slot], key)) {
+            slot = (slot + 1) & mask_;
+        }
+        return slot;
+    }
+
+    void resize(std::size_t slots) {
+        std::vector<Key> keys(slots);
+        std::vector<Value> values(slots);
+        std::vector<Index> generations(slots, 0);
+        std::swap(keys, keys_);
+        std::swap(values, values_);
+        std::swap(generations, generations_);
+        const auto generation = generation_;
+        generation_ = 1;
+        mask_ = slots - 1;
+        shift_ = 64;
+        for (std::size_t value = slots; value > 1; value /= 2) {
+            --shift_;
+        }
+        size_ = 0;
+        for (std::size_t slot = 0; slot < keys.size(); ++slot) {
+            if (generations[slot] == generation) {
+                const auto new_slot = find_slot(keys[slot]);
+                keys_[new_slot] = std::move(keys[slot]);
+                values_[new_slot] = std::move(values[slot]);
+                generations_[new_slot] = generation_;
+                ++size_;
+            }
+        }
+    }
+};
+
+template <class Key, class Hash = std::hash<Key>, class Equal = std::equal_to<Key>>
+class FlatHashSet {
+public:
+    FlatHashSet(std::size_t capacity = 16) : map_(capacity) {}
+
+    std::size_t size() const {
+        return map_.size();
+    }
+
+    bool empty() const {
+        return map_.empty();
+    }
+
+    bool count(const Key& key) const {
+        return map_.find(key) != nullptr;
+    }
+
+    bool insert(const Key& key) {
+        return map_.insert(key, 1).second;
+    }
+
+    void clear() {
+        map_.clear();
+    }
+
+private:
+    FlatHashMap<Key, char, Hash, Equal> map_;
+};
+
+}
@@ -0,0 +1,316 @@
+#include "flow_field.hpp"
+#include "indexed_heap.hpp"
+#include "helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace strategy {
+
+namespace {
+
+constexpr double OCTILE_TO_EUCLIDEAN_MAX_RATIO = 1.0824;
+
+}
+
+FlowField::FlowField(double map_size, double cell_size)
+        : cell_size_(cell_size),
+          cells_per_side_(std::size_t(std::ceil(map_size / cell_size))),
+          blocked_(cells_per_side_ * cells_per_side_, false),
+          distances_(cells_per_side_ * cells_per_side_, std::numeric_limits<double>::max()),
+          next_(cells_per_side_ * cells_per_side_, cells_per_side_ * cells_per_side_),
+          affected_(cells_per_side_ * cells_per_side_, false) {
+}
+
+FlowField::Cell FlowField::get_cell(const Point& position) const {
+    const auto get_index = [&] (double value) {
+        return std::size_t(std::min(double(cells_per_side_ - 1), std::max(0.0, std::floor(value / cell_size_))));
+    };
+    return get_index(position.x()) + cells_per_side_ * get_index(position.y());
+}
+
+Point FlowField::get_center(Cell cell) const {
+    return Point((double(cell % cells_per_side_) + 0.5) * cell_size_, (double(cell / cells_per_side_) + 0.5) * cell_size_);
+}
+
+double FlowField::distance(const Point& position) const {
+    return distances_[get_cell(position)];
+}
+
+double FlowField::get_lower_bound(const Point& position) const {
+    const auto value = distance(position);
+    if (value == std::numeric_limits<double>::max()) {
+        return 0;
+    }
+    return std::max(0.0, value / OCTILE_TO_EUCLIDEAN_MAX_RATIO - cell_size_ * std::sqrt(2.0));
+}
+
+void FlowField::sources(const std::vector<Point>& positions) {
+    sources_.clear();
+    std::fill(distances_.begin(), distances_.end(), std::numeric_limits<double>::max());
+    std::fill(next_.begin(), next_.end(), next_.size());
+    for (const auto& position : positions) {
+        const auto cell = get_cell(position);
+        sources_.push_back(cell);
+        distances_[cell] = 0;
+        next_[cell] = cell;
+    }
+    changed_.clear();
+    propagate(sources_);
+}
+
+void FlowField::blocked(Cell cell, bool value) {
+    if (bool(blocked_[cell]) != value) {
+        blocked_[cell] = value;
+        changed_.push_back(cell);
+    }
+}
+
+void FlowField::update() {
+    if (changed_.empty()) {
+        updated_cells_count_ = 0;
+        return;
+    }
+
+    const auto infinity = std::numeric_limits<double>::max();
+    const auto cells_count = next_.size();
+
+    roots_.clear();
+    relaxed_.clear();
+
+    const auto is_passable = [&] (Cell cell) {
+        return !blocked_[cell] || is_source(cell);
+    };
+
+    const auto is_arc_allowed = [&] (Cell src, Cell dst) {
+        if (!is_passable(src) || !is_passable(dst)) {
+            return false;
+        }
+        const auto src_x = src % cells_per_side_;
+        const auto dst_x = dst % cells_per_side_;
+        if (src_x == dst_x || src / cells_per_side_ == dst / cells_per_side_) {
+            return true;
+        }
+        return is_passable(dst_x + cells_per_side_ * (src / cells_per_side_))
+                && is_passable(src_x + cells_per_side_ * (dst / cells_per_side_));
+    };
+
+    const auto add_root = [&] (Cell cell) {
+        if (!affected_[cell] && !is_source(cell)) {
+            affected_[cell] = true;
+            roots_.push_back(cell);
+        }
+    };
+
+    const auto for_each_cell_around = [&] (Cell cell, const auto& function) {
+        const auto x = cell % cells_per_side_;
+        const auto y = cell / cells_per_side_;
+        for (auto ny = y ? y - 1 : y; ny <= std::min(y + 1, cells_per_side_ - 1); ++ny) {
+            for (auto nx = x ? x - 1 : x; nx <= std::min(x + 1, cells_per_side_ - 1); ++nx) {
+                function(nx + cells_per_side_ * ny);
+            }
+        }
+    };
+
+    for (const auto cell : changed_) {
+        if (blocked_[cell]) {
+            add_root(cell);
+        }
+        for_each_cell_around(cell, [&] (Cell other) {
+            if (next_[other] != cells_count && !is_source(other) && !is_arc_allowed(other, next_[other])) {
+                add_root(other);
+            }
+        });
+    }
+
+    for (std::size_t i = 0; i < roots_.size(); ++i) {
+        const auto parent = roots_[i];
+        for_each_cell_around(parent, [&] (Cell child) {
+            if (next_[child] == parent) {
+                add_root(child);
+            }
+        });
+    }
+
+    for (const auto cell : roots_) {
+        distances_[cell] = infinity;
+        next_[cell] = cells_count;
+    }
+
+    for (const auto cell : roots_) {
+        relax(cell, relaxed_);
+        affected_[cell] = false;
+    }
+
+    for (const auto cell : changed_) {
+        for_each_cell_around(cell, [&] (Cell other) { this->relax(other, relaxed_); });
+    }
+
+    changed_.clear();
+    propagate(relaxed_);
+}
+
+template <class Function>
+void FlowField::for_each_neighbour(Cell cell, const Function& function) const {
+    const auto straight = cell_size_;
+    const auto diagonal = cell_size_ * std::sqrt(2.0);
+    const auto is_passable = [&] (std::size_t x, std::size_t y) {
+        const auto other = x + cells_per_side_ * y;
+        return !blocked_[other] || is_source(other);
+    };
+    const auto x = cell % cells_per_side_;
+    const auto y = cell / cells_per_side_;
+    for (auto ny = y ? y - 1 : y; ny <= std::min(y + 1, cells_per_side_ - 1); ++ny) {
+        for (auto nx = x ? x - 1 : x; nx <= std::min(x + 1, cells_per_side_ - 1); ++nx) {
+            if ((nx == x && ny == y) || !is_passable(nx, ny)) {
+                continue;
+            }
+            const auto is_diagonal = nx != x && ny != y;
+            if (is_diagonal && (!is_passable(nx, y) || !is_passable(x, ny))) {
+                continue;
+            }
+            function(nx + cells_per_side_ * ny, is_diagonal ? diagonal : straight);
+        }
+    }
+}
+
+void FlowField::relax(Cell cell, std::vector<Cell>& changed) {
+    if (blocked_[cell] || is_source(cell)) {
+        return;
+    }
+    for_each_neighbour(cell, [&] (Cell other, double length) {
+        if (distances_[other] != std::numeric_limits<double>::max() && distances_[other] + length < distances_[cell]) {
+            distances_[cell] = distances_[other] + length;
+            next_[cell] = other;
+            changed.push_back(cell);
+        }
+    });
+}
+
+void FlowField::propagate(const std::vector<Cell>& changed) {
+    IndexedHeap queue(distances_);
+    for (const auto cell : changed) {
+        queue.push_or_decrease(cell);
+    }
+    updated_cells_count_ = 0;
+    while (!queue.empty()) {
+        const auto cell = queue.pop();
+        ++updated_cells_count_;
+        for_each_neighbour(cell, [&] (Cell other, double length) {
+            const auto distance = distances_[cell] + length;
+            if (distance < distances_[other] && !is_source(other)) {
+                distances_[other] = distance;
+                next_[other] = cell;
+                queue.push_or_decrease(other);
+            }
+        });
+    }
+}
+
+std::vector<char> get_blocked_cells(const FlowField& field, const FullCache& cache, double inflation) {
+    std::vector<char> blocked;
+    get_blocked_cells(field, cache, inflation, blocked);
+    return blocked;
+}
+
+void get_blocked_cells(const FlowField& field, const FullCache& cache, double inflation, std::vector<char>& blocked) {
+    blocked.assign(field.cells_per_side() * field.cells_per_side(), false);
+
+    const auto half = 0.5 * field.cell_size();
+    const auto is_covered = [&] (FlowField::Cell cell, const Point& position, double radius) {
+        const auto center = field.get_center(cell);
+        const auto dx = std::abs(center.x() - position.x()) + half;
+        const auto dy = std::abs(center.y() - position.y()) + half;
+        return dx * dx + dy * dy <= radius * radius;
+    };
+
+    const auto add = [&] (const auto& units) {
+        for (const auto& v : units) {
+            const auto& unit = v.second.value();
+            const auto position = get_position(unit);
+            const auto radius = unit.getRadius() + inflation;
+            const auto min = field.get_cell(position - Point(radius, radius));
+            const auto max = field.get_cell(position + Point(radius, radius));
+            const auto side = field.cells_per_side();
+            for (auto y = min / side; y <= max / side; ++y) {
+                for (auto x = min % side; x <= max % side; ++x) {
+                    const auto cell = x + side * y;
+                    if (is_covered(cell, position, radius)) {
+                        blocked[cell] = true;
+                    }
+                }
+            }
+        }
+    };
+
+    add(get_units<model::Tree>(cache));
+    add(get_units<model::Building>(cache));
+}
+
+FlowFields::FlowFields(const WorldGraph& graph, double map_size, double inflation)
+        : graph_(graph),
+          map_size_(map_size),
+          inflation_(inflation),
+          layout_(map_size, FLOW_FIELD_CELL_SIZE),
+          blocked_(layout_.cells_per_side() * layout_.cells_per_side(), false) {
+    fields_.reserve(FLOW_FIELDS_MAX_COUNT);
+}
+
+const FlowField* FlowFields::get(const Point& target) {
+    const auto& node = graph_.get_nearest_node(target);
+
+    if (node.position != target) {
+        return nullptr;
+    }
+
+    ++uses_count_;
+
+    const auto existing = std::find_if(fields_.begin(), fields_.end(),
+        [&] (const Entry& entry) { return entry.node == node.id; });
+
+    if (existing != fields_.end()) {
+        existing->last_use = uses_count_;
+        return &existing->field;
+    }
+
+    Entry* entry;
+
+    if (fields_.size() < FLOW_FIELDS_MAX_COUNT) {
+        fields_.push_back(Entry {node.id, uses_count_, FlowField(map_size_, FLOW_FIELD_CELL_SIZE)});
+        entry = &fields_.back();
+    } else {
+        entry = &*std::min_element(fields_.begin(), fields_.end(),
+            [] (const Entry& lhs, const Entry& rhs) { return lhs.last_use < rhs.last_use; });
+        entry->node = node.id;
+        entry->last_use = uses_count_;
+    }
+
+    for (FlowField::Cell cell = 0; cell < blocked_.size(); ++cell) {
+        entry->field.blocked(cell, blocked_[cell]);
+    }
+
+    entry->field.sources({node.position});
+
+    return &entry->field;
+}
+
+void FlowFields::update(const FullCache& cache) {
+    get_blocked_cells(layout_, cache, inflation_, next_blocked_);
+
+    for (FlowField::Cell cell = 0; cell < next_blocked_.size(); ++cell) {
+        if (next_blocked_[cell] != blocked_[cell]) {
+            for (auto& entry : fields_) {
+                entry.field.blocked(cell, next_blocked_[cell]);
+            }
+        }
+    }
+
+    std::swap(blocked_, next_blocked_);
+
+    for (auto& entry : fields_) {
+        entry.field.update();
+    }
+}
+
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "world_graph.hpp"
+#include "cache.hpp"
+
+#include <vector>
+
+namespace strategy {
+
+class FlowField {
+public:
+    using Cell = std::size_t;
+
+    FlowField(double map_size, double cell_size);
+
+    std::size_t cells_per_side() const {
+        return cells_per_side_;
+    }
+
+    double cell_size() const {
+        return cell_size_;
+    }
+
+    bool is_blocked(Cell cell) const {
+        return blocked_[cell];
+    }
+
+    bool is_source(Cell cell) const {
+        return next_[cell] == cell;
+    }
+
+    double distance(Cell cell) const {
+        return distances_[cell];
+    }
+
+    std::size_t updated_cells_count() const {
+        return updated_cells_count_;
+    }
+
+    Cell get_cell(const Point& position) const;
+    Point get_center(Cell cell) const;
+    double distance(const Point& position) const;
+    double get_lower_bound(const Point& position) const;
+    void sources(const std::vector<Point>& positions);
+    void blocked(Cell cell, bool value);
+    void update();
+
+private:
+    double cell_size_;
+    std::size_t cells_per_side_;
+    std::vector<char> blocked_;
+    std::vector<double> distances_;
+    std::vector<Cell> next_;
+    std::vector<Cell> sources_;
+    std::vector<Cell> changed_;
+    std::vector<char> affected_;
+    std::vector<Cell> roots_;
+    std::vector<Cell> relaxed_;
+    std::size_t updated_cells_count_ = 0;
+
+    template <class Function>
+    void for_each_neighbour(Cell cell, const Function& function) const;
+    void propagate(const std::vector<Cell>& changed);
+    void relax(Cell cell, std::vector<Cell>& changed);
+};
+
+std::vector<char> get_blocked_cells(const FlowField& field, const FullCache& cache, double inflation);
+void get_blocked_cells(const FlowField& field, const FullCache& cache, double inflation, std::vector<char>& blocked);
+
+class FlowFields {
+public:
+    FlowFields(const WorldGraph& graph, double map_size, double inflation);
+
+    std::size_t size() const {
+        return fields_.size();
+    }
+
+    const FlowField* get(const Point& target);
+    void update(const FullCache& cache);
+
+private:
+    struct Entry {
+        WorldGraph::NodeId node;
+        std::size_t last_use;
+        FlowField field;
+    };
+
+    const WorldGraph& graph_;
+    double map_size_;
+    double inflation_;
+    FlowField layout_;
+    std::vector<char> blocked_;
+    std::vector<char> next_blocked_;
+    std::vector<Entry> fields_;
+    std::size_t uses_count_ = 0;
+};
+
+}
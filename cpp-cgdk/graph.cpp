@@ -1,45 +1,78 @@
 #include "graph.hpp"
+#include "indexed_heap.hpp"
 
 #include <algorithm>
+#include <sstream>
+#include <stdexcept>
 
 namespace strategy {
 
+void Graph::build() {
+    std::fill(offsets_.begin(), offsets_.end(), 0);
+    adjacency_.clear();
+    for (Node src = 0; src < size_; ++src) {
+        for (Node dst = 0; dst < size_; ++dst) {
+            const auto weight = arcs_.get(src, dst);
+            if (weight != std::numeric_limits<double>::max()) {
+                adjacency_.push_back(Arc {dst, weight});
+            }
+        }
+        offsets_[src + 1] = adjacency_.size();
+    }
+    adjacency_built_ = true;
+}
+
 Graph::Path Graph::get_shortest_path(Node src, Node dst) const {
+    return get_shortest_paths(src, dst).path(dst);
+}
+
+Graph::ShortestPathTree Graph::get_shortest_paths(Node src) const {
+    return get_shortest_paths(src, size_);
+}
+
+Graph::ShortestPathTree Graph::get_shortest_paths(Node src, Node dst) const {
+    if (!adjacency_built_) {
+        std::ostringstream error;
+        error << "Graph adjacency is not built after arcs update in " << __PRETTY_FUNCTION__
+              << " at " << __FILE__ << ":" << __LINE__;
+        throw std::logic_error(error.str());
+    }
     std::vector<double> lengths(size_, std::numeric_limits<double>::max());
-    lengths[src] = 0;
-    const auto less_priority = [&] (Node lhs, Node rhs) {
-        return lengths[lhs] > lengths[rhs];
-    };
-    std::priority_queue<Node, std::vector<Node>, decltype(less_priority)> queue(less_priority);
     std::vector<Node> came_from(size_, size_);
-    queue.push(src);
+    std::vector<std::size_t> nodes_counts(size_, 0);
+    IndexedHeap queue(lengths);
+    lengths[src] = 0;
+    nodes_counts[src] = 1;
+    queue.push_or_decrease(src);
     while (!queue.empty()) {
-        const auto node = queue.top();
-        queue.pop();
-        for (Node other = 0; other < size_; ++other) {
-            const auto weight = arcs_.get(node, other);
-            if (weight != std::numeric_limits<double>::max()) {
-                const auto length = lengths[node] + weight;
-                if (length < lengths[other]) {
-                    lengths[other] = length;
-                    came_from[other] = node;
-                    queue.push(other);
-                }
+        const auto node = queue.pop();
+        if (node == dst) {
+            break;
+        }
+        for (auto arc = arcs_begin(node); arc != arcs_end(node); ++arc) {
+            const auto length = lengths[node] + arc->weight;
+            if (length < lengths[arc->dst]) {
+                lengths[arc->dst] = length;
+                came_from[arc->dst] = node;
+                nodes_counts[arc->dst] = nodes_counts[node] + 1;
+                queue.push_or_decrease(arc->dst);
             }
         }
     }
-    return came_from[dst] == size_ ? Path {0, {}} : Path {lengths[dst], reconstruct_path(dst, came_from)};
+    return ShortestPathTree(src, std::move(lengths), std::move(came_from), std::move(nodes_counts));
 }
 
-std::vector<Graph::Node> Graph::reconstruct_path(Node node, const std::vector<Node>& came_from) const {
+Graph::Path Graph::ShortestPathTree::path(Node dst) const {
+    if (!has_path(dst)) {
+        return Path {0, {}};
+    }
     std::vector<Node> nodes;
-    nodes.reserve(came_from.size());
-    while (node != size_) {
+    nodes.reserve(nodes_count(dst));
+    for (auto node = dst; node != came_from_.size(); node = came_from_[node]) {
         nodes.push_back(node);
-        node = came_from.at(node);
     }
     std::reverse(nodes.begin(), nodes.end());
-    return nodes;
+    return Path {lengths_[dst], std::move(nodes)};
 }
 
 }
@@ -1,7 +1,8 @@
 #pragma once
 
 #include <limits>
-#include <queue>
+#include <utility>
+#include <vector>
 
 namespace strategy {
 
@@ -35,23 +36,91 @@ public:
         std::vector<Node> nodes;
     };
 
-    Graph(std::size_t size) : size_(size), arcs_(size, std::numeric_limits<double>::max()) {}
+    class ShortestPathTree {
+    public:
+        ShortestPathTree(Node source, std::vector<double> lengths, std::vector<Node> came_from,
+                         std::vector<std::size_t> nodes_counts)
+            : source_(source), lengths_(std::move(lengths)), came_from_(std::move(came_from)),
+              nodes_counts_(std::move(nodes_counts)) {}
+
+        Node source() const {
+            return source_;
+        }
+
+        bool has_path(Node dst) const {
+            return came_from_[dst] != came_from_.size();
+        }
+
+        double length(Node dst) const {
+            return has_path(dst) ? lengths_[dst] : 0;
+        }
+
+        std::size_t nodes_count(Node dst) const {
+            return has_path(dst) ? nodes_counts_[dst] : 0;
+        }
+
+        Path path(Node dst) const;
+
+    private:
+        Node source_;
+        std::vector<double> lengths_;
+        std::vector<Node> came_from_;
+        std::vector<std::size_t> nodes_counts_;
+    };
+
+    struct Arc {
+        Node dst;
+        double weight;
+    };
+
+    Graph(std::size_t size)
+        : size_(size), arcs_(size, std::numeric_limits<double>::max()), offsets_(size + 1, 0) {}
+
+    std::size_t size() const {
+        return size_;
+    }
 
     void arc(Node src, Node dst, double weight) {
         arcs_.set(src, dst, weight);
+        adjacency_built_ = false;
     }
 
     const Matrix& arcs() const {
         return arcs_;
     }
 
+    std::size_t arcs_count() const {
+        return adjacency_.size();
+    }
+
+    const Arc& arc(std::size_t index) const {
+        return adjacency_[index];
+    }
+
+    std::size_t arc_index(const Arc* arc) const {
+        return std::size_t(arc - adjacency_.data());
+    }
+
+    const Arc* arcs_begin(Node src) const {
+        return adjacency_.data() + offsets_[src];
+    }
+
+    const Arc* arcs_end(Node src) const {
+        return adjacency_.data() + offsets_[src + 1];
+    }
+
+    void build();
     Path get_shortest_path(Node src, Node dst) const;
+    ShortestPathTree get_shortest_paths(Node src) const;
 
 private:
     std::size_t size_;
     Matrix arcs_;
+    std::vector<std::size_t> offsets_;
+    std::vector<Arc> adjacency_;
+    bool adjacency_built_ = true;
 
-    std::vector<Node> reconstruct_path(Node node, const std::vector<Node>& came_from) const;
+    ShortestPathTree get_shortest_paths(Node src, Node dst) const;
 };
 
 }
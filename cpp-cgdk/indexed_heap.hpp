@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+
+namespace strategy {
+
+class IndexedHeap {
+public:
+    IndexedHeap(const std::vector<double>& keys)
+        : keys_(keys), positions_(keys.size(), keys.size()) {
+        heap_.reserve(keys.size());
+    }
+
+    bool empty() const {
+        return heap_.empty();
+    }
+
+    void push_or_decrease(std::size_t node) {
+        if (positions_[node] == keys_.size()) {
+            positions_[node] = heap_.size();
+            heap_.push_back(node);
+        }
+        sift_up(positions_[node]);
+    }
+
+    std::size_t pop() {
+        const auto result = heap_.front();
+        positions_[result] = keys_.size();
+        heap_.front() = heap_.back();
+        heap_.pop_back();
+        if (!heap_.empty()) {
+            positions_[heap_.front()] = 0;
+            sift_down(0);
+        }
+        return result;
+    }
+
+private:
+    const std::vector<double>& keys_;
+    std::vector<std::size_t> positions_;
+    std::vector<std::size_t> heap_;
+
+    void sift_up(std::size_t position) {
+        const auto node = heap_[position];
+        while (position > 0) {
+            const auto parent = (position - 1) / 2;
+            if (keys_[heap_[parent]] <= keys_[node]) {
+                break;
+            }
+            move(parent, position);
+            position = parent;
+        }
+        place(node, position);
+    }
+
+    void sift_down(std::size_t position) {
+        const auto node = heap_[position];
+        while (true) {
+            auto child = 2 * position + 1;
+            if (child >= heap_.size()) {
+                break;
+            }
+            if (child + 1 < heap_.size() && keys_[heap_[child + 1]] < keys_[heap_[child]]) {
+                ++child;
+            }
+            if (keys_[node] <= keys_[heap_[child]]) {
+                break;
+            }
+            move(child, position);
+            position = child;
+        }
+        place(node, position);
+    }
+
+    void move(std::size_t from, std::size_t to) {
+        heap_[to] = heap_[from];
+        positions_[heap_[to]] = to;
+    }
+
+    void place(std::size_t node, std::size_t position) {
+        heap_[position] = node;
+        positions_[node] = position;
+    }
+};
+
+}
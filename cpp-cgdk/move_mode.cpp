@@ -16,7 +16,8 @@ std::ostream& operator <<(std::ostream& stream, const std::vector<WorldGraph::No
 MoveMode::MoveMode(const WorldGraph& graph)
         : graph_(graph),
           destination_(false, WorldGraph::Node()),
-          move_to_node_({})  {
+          move_to_node_({}),
+          safe_paths_(graph) {
 }
 
 MoveMode::Result MoveMode::apply(const Context& context) {
@@ -29,6 +30,29 @@ MoveMode::Result MoveMode::apply(const Context& context) {
     return move_to_node_.at_end() ? Result() : Result(Target(), move_to_node_.path_node()->position);
 }
 
+Corridor MoveMode::corridor(const Context& context) const {
+    Corridor result(OPTIMAL_PATH_CORRIDOR_WIDTH);
+
+    if (move_to_node_.at_end()) {
+        return result;
+    }
+
+    const auto& path = move_to_node_.path();
+    const auto node = move_to_node_.path_node();
+
+    result.add(get_position(context.self()), node->position);
+
+    if (node != path.begin()) {
+        result.add(std::prev(node)->position, node->position);
+    }
+
+    if (std::next(node) != path.end()) {
+        result.add(node->position, std::next(node)->position);
+    }
+
+    return result;
+}
+
 void MoveMode::reset() {
     destination_.first = false;
     move_to_node_ = MoveToNode({});
@@ -52,6 +76,7 @@ void MoveMode::handle_messages(const Context& context) {
 
 void MoveMode::update_path(const Context& context) {
     if (destination_.first && !move_to_node_.at_end()) {
+        update_safe_path(context);
         return;
     }
     const auto destination = get_optimal_destination(context, graph_, target_lane_, context.self());
@@ -59,8 +84,9 @@ void MoveMode::update_path(const Context& context) {
         return;
     }
     destination_ = {true, destination};
-    const auto nearest_node = get_nearest_node(graph_.nodes(), get_position(context.self()));
-    auto path = graph_.get_shortest_path(nearest_node.id, destination.id).nodes;
+    const auto& nearest_node = graph_.get_nearest_node(get_position(context.self()));
+    safe_paths_.update(context, destination.id);
+    auto path = safe_paths_.get_path(nearest_node.id).nodes;
     if (path.empty()) {
         path.push_back(nearest_node);
     }
@@ -73,6 +99,34 @@ void MoveMode::update_path(const Context& context) {
         << '\n';
 }
 
+void MoveMode::update_safe_path(const Context& context) {
+    safe_paths_.update(context, destination_.second.id);
+    const auto node = move_to_node_.path_node();
+    const auto source = node->id;
+    const auto safe_path = safe_paths_.get_path(source);
+    auto path = safe_path.nodes;
+    if (path.empty()) {
+        path.push_back(*node);
+    }
+    const std::vector<WorldGraph::Node> remaining(node, move_to_node_.path().end());
+    const auto same = path.size() == remaining.size() && std::equal(path.begin(), path.end(), remaining.begin(),
+        [] (const auto& lhs, const auto& rhs) { return lhs.id == rhs.id; });
+    if (same) {
+        return;
+    }
+    if (remaining.back().id == destination_.second.id
+            && safe_path.length > (1 - MOVE_MODE_SAFE_PATH_MIN_IMPROVEMENT) * safe_paths_.get_length(remaining)) {
+        return;
+    }
+    move_to_node_ = MoveToNode(std::move(path));
+
+    SLOG(context) << "move_to_safe_node"
+        << " source=" << source
+        << ", destination=" << destination_.second.id
+        << ", path=" << move_to_node_.path()
+        << '\n';
+}
+
 void MoveMode::next_path_node(const Context& context) {
     move_to_node_.next(context);
 }
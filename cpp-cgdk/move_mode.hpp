@@ -2,6 +2,8 @@
 
 #include "mode.hpp"
 #include "move_to_node.hpp"
+#include "corridor.hpp"
+#include "safe_paths.hpp"
 
 namespace strategy {
 
@@ -25,6 +27,8 @@ public:
         return target_lane_;
     }
 
+    Corridor corridor(const Context& context) const;
+
     Result apply(const Context& context) override final;
     void reset() override final;
 
@@ -34,9 +38,11 @@ private:
     model::LaneType target_lane_ = model::_LANE_UNKNOWN_;
     Tick last_message_ = 0;
     MoveToNode move_to_node_;
+    SafePaths safe_paths_;
 
     void handle_messages(const Context& context);
     void update_path(const Context& context);
+    void update_safe_path(const Context& context);
     void next_path_node(const Context& context);
 };
 
@@ -1,38 +1,86 @@
 #include "move_to_position.hpp"
 #include "action.hpp"
+#include "time_limited_strategy.hpp"
 
 namespace strategy {
 
-MoveToPosition::MoveToPosition(const Context& context, const Point& destination, const Target& target)
-        : destination_(destination), target_(target) {
-    calculate_movements(context);
+MoveToPosition::MoveToPosition(const Context& context, const Point& destination, const Target& target,
+                               PathSearchStorage* path_search_storage, const TangentGraph* tangent_graph,
+                               const Corridor* corridor, const FlowField* flow_field)
+        : destination_(destination), target_(target), path_search_storage_(path_search_storage),
+          tangent_graph_(tangent_graph), corridor_(corridor), flow_field_(flow_field) {
+    calculate_movements(context, nullptr);
 }
 
 void MoveToPosition::next(const Context& context) {
-    calculate_movements(context);
+    if (can_reuse_path(context)) {
+        path_update_ = PathUpdate::REUSED;
+        ++state_;
+        ++movement_;
+        return;
+    }
+
+    path_update_ = PathUpdate::REPLANNED;
+    calculate_movements(context, &path_);
 }
 
-void MoveToPosition::calculate_movements(const Context& context) {
+bool MoveToPosition::can_reuse_path(const Context& context) const {
+    if (movement_ == movements_.end() || std::next(movement_) == movements_.end()) {
+        return false;
+    }
+
+    if (get_look_target(context) != look_target_) {
+        return false;
+    }
+
+    const auto& expected = *std::next(state_);
+
+    if (expected.position().distance(get_position(context.self())) > MOVE_TO_POSITION_MAX_POSITION_ERROR
+            || std::abs(normalize_angle(expected.angle() - context.self().getAngle())) > MOVE_TO_POSITION_MAX_ANGLE_ERROR) {
+        return false;
+    }
+
+    return IsPathValid()
+            .max_ticks(OPTIMAL_PATH_MAX_TICKS)
+            .storage(path_search_storage_)
+            (context, get_remaining_path(path_, get_position(context.self())));
+}
+
+OptPoint MoveToPosition::get_look_target(const Context& context) const {
+    if (const auto unit = target_.circular_unit(context.cache())) {
+        return {true, get_optimal_target_position(*unit)};
+    }
+    return {false, Point()};
+}
+
+void MoveToPosition::calculate_movements(const Context& context, const Path* previous_path) {
 #ifdef ELSID_STRATEGY_DEBUG
     ticks_states_.clear();
     steps_states_.clear();
 #endif
+    using Ms = std::chrono::duration<double, std::milli>;
+
     const auto bounds = make_unit_bounds(context.self(), context.game());
+    const auto base_time_limit = Ms(TimeLimitedStrategy::get_base_time_limit_per_tick(context.self().isMaster()));
     path_ = GetOptimalPath()
             .step_size(bounds.max_speed(0) + 1)
             .max_ticks(OPTIMAL_PATH_MAX_TICKS)
             .max_iterations(OPTIMAL_PATH_MAX_ITERATIONS)
+            .storage(path_search_storage_)
+            .tangent_graph(tangent_graph_)
+            .previous_path(previous_path)
+            .anytime(true)
+            .anytime_time_budget(OPTIMAL_PATH_ANYTIME_TIME_BUDGET_SHARE * base_time_limit)
+            .corridor(corridor_)
+            .flow_field(flow_field_)
 #ifdef ELSID_STRATEGY_DEBUG
             .ticks_states(&ticks_states_)
             .steps_states(&steps_states_)
 #endif
             (context, destination_);
 
-    if (const auto unit = target_.circular_unit(context.cache())) {
-        std::tie(states_, movements_) = get_optimal_movement(context, path_, {true, get_optimal_target_position(*unit)});
-    } else {
-        std::tie(states_, movements_) = get_optimal_movement(context, path_, {false, Point()});
-    }
+    look_target_ = get_look_target(context);
+    std::tie(states_, movements_) = get_optimal_movement(context, path_, look_target_);
 
     state_ = states_.begin();
     movement_ = movements_.begin();
@@ -6,9 +6,17 @@
 
 namespace strategy {
 
+enum class PathUpdate {
+    BUILT,
+    REUSED,
+    REPLANNED,
+};
+
 class MoveToPosition {
 public:
-    MoveToPosition(const Context& context, const Point& destination, const Target& target);
+    MoveToPosition(const Context& context, const Point& destination, const Target& target,
+                   PathSearchStorage* path_search_storage = nullptr, const TangentGraph* tangent_graph = nullptr,
+                   const Corridor* corridor = nullptr, const FlowField* flow_field = nullptr);
 
     void next(const Context& context);
 
@@ -36,9 +44,17 @@ public:
         return steps_states_;
     }
 
+    PathUpdate path_update() const {
+        return path_update_;
+    }
+
 private:
     Point destination_;
     Target target_;
+    PathSearchStorage* path_search_storage_;
+    const TangentGraph* tangent_graph_;
+    const Corridor* corridor_;
+    const FlowField* flow_field_;
     Path path_;
     MovementsStates states_;
     Movements movements_;
@@ -46,8 +62,12 @@ private:
     Movements::const_iterator movement_;
     std::map<int, TickState> ticks_states_;
     std::vector<StepState> steps_states_;
+    OptPoint look_target_;
+    PathUpdate path_update_ = PathUpdate::BUILT;
 
-    void calculate_movements(const Context& context);
+    void calculate_movements(const Context& context, const Path* previous_path);
+    bool can_reuse_path(const Context& context) const;
+    OptPoint get_look_target(const Context& context) const;
 };
 
 } // namespace strategy
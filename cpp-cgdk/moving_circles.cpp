@@ -0,0 +1,133 @@
+#include "moving_circles.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace strategy {
+
+void MovingCircles::clear() {
+    x_.clear();
+    y_.clear();
+    final_x_.clear();
+    final_y_.clear();
+    radius_.clear();
+}
+
+void MovingCircles::reserve(std::size_t size) {
+    x_.reserve(size);
+    y_.reserve(size);
+    final_x_.reserve(size);
+    final_y_.reserve(size);
+    radius_.reserve(size);
+}
+
+void MovingCircles::add(const Circle& circle, const Point& final_position) {
+    x_.push_back(circle.position().x());
+    y_.push_back(circle.position().y());
+    final_x_.push_back(final_position.x());
+    final_y_.push_back(final_position.y());
+    radius_.push_back(circle.radius());
+}
+
+namespace {
+
+using simd::ScalarOps;
+using simd::VectorOps;
+
+struct Segment {
+    double x;
+    double y;
+    double dx;
+    double dy;
+    double radius;
+};
+
+template <class Ops>
+typename Ops::Value get_distance_squared(typename Ops::Value x, typename Ops::Value y,
+                                         typename Ops::Value begin_x, typename Ops::Value begin_y,
+                                         typename Ops::Value dx, typename Ops::Value dy,
+                                         typename Ops::Value squared_length) {
+    const auto to_x = Ops::sub(x, begin_x);
+    const auto to_y = Ops::sub(y, begin_y);
+    const auto dot = Ops::add(Ops::mul(to_x, dx), Ops::mul(to_y, dy));
+    const auto safe_length = Ops::max(squared_length, Ops::set(std::numeric_limits<double>::min()));
+    const auto t = Ops::min(Ops::set(1), Ops::max(Ops::set(0), Ops::div(dot, safe_length)));
+    const auto diff_x = Ops::sub(to_x, Ops::mul(dx, t));
+    const auto diff_y = Ops::sub(to_y, Ops::mul(dy, t));
+    return Ops::add(Ops::mul(diff_x, diff_x), Ops::mul(diff_y, diff_y));
+}
+
+template <class Ops>
+typename Ops::Value cross(typename Ops::Value lhs_x, typename Ops::Value lhs_y,
+                          typename Ops::Value rhs_x, typename Ops::Value rhs_y) {
+    return Ops::sub(Ops::mul(lhs_x, rhs_y), Ops::mul(lhs_y, rhs_x));
+}
+
+template <class Ops>
+std::size_t has_intersection(const Segment& segment, const double* x, const double* y,
+                             const double* final_x, const double* final_y, const double* radius,
+                             std::size_t begin, std::size_t end, double max_error, char* result) {
+    const auto p_x = Ops::set(segment.x);
+    const auto p_y = Ops::set(segment.y);
+    const auto p_dx = Ops::set(segment.dx);
+    const auto p_dy = Ops::set(segment.dy);
+    const auto p_end_x = Ops::set(segment.x + segment.dx);
+    const auto p_end_y = Ops::set(segment.y + segment.dy);
+    const auto p_squared_length = Ops::set(segment.dx * segment.dx + segment.dy * segment.dy);
+    const auto p_radius = Ops::set(segment.radius + max_error);
+    const auto zero = Ops::set(0);
+
+    auto i = begin;
+
+    for (; i + Ops::width <= end; i += Ops::width) {
+        const auto q_x = Ops::load(x + i);
+        const auto q_y = Ops::load(y + i);
+        const auto q_end_x = Ops::load(final_x + i);
+        const auto q_end_y = Ops::load(final_y + i);
+        const auto q_dx = Ops::sub(q_end_x, q_x);
+        const auto q_dy = Ops::sub(q_end_y, q_y);
+        const auto q_squared_length = Ops::add(Ops::mul(q_dx, q_dx), Ops::mul(q_dy, q_dy));
+        const auto max_distance = Ops::add(p_radius, Ops::load(radius + i));
+
+        const auto distance_squared = Ops::min(
+            Ops::min(get_distance_squared<Ops>(p_x, p_y, q_x, q_y, q_dx, q_dy, q_squared_length),
+                     get_distance_squared<Ops>(p_end_x, p_end_y, q_x, q_y, q_dx, q_dy, q_squared_length)),
+            Ops::min(get_distance_squared<Ops>(q_x, q_y, p_x, p_y, p_dx, p_dy, p_squared_length),
+                     get_distance_squared<Ops>(q_end_x, q_end_y, p_x, p_y, p_dx, p_dy, p_squared_length)));
+
+        const auto p_begin_side = cross<Ops>(p_dx, p_dy, Ops::sub(q_x, p_x), Ops::sub(q_y, p_y));
+        const auto p_end_side = cross<Ops>(p_dx, p_dy, Ops::sub(q_end_x, p_x), Ops::sub(q_end_y, p_y));
+        const auto q_begin_side = cross<Ops>(q_dx, q_dy, Ops::sub(p_x, q_x), Ops::sub(p_y, q_y));
+        const auto q_end_side = cross<Ops>(q_dx, q_dy, Ops::sub(p_end_x, q_x), Ops::sub(p_end_y, q_y));
+        const auto crossing = Ops::both(Ops::less(Ops::mul(p_begin_side, p_end_side), zero),
+                                        Ops::less(Ops::mul(q_begin_side, q_end_side), zero));
+
+        Ops::store(Ops::any(crossing, Ops::less(distance_squared, Ops::mul(max_distance, max_distance))), result + i);
+    }
+
+    return i;
+}
+
+}
+
+void MovingCircles::has_intersection(const Circle& circle, const Point& final_position, std::vector<char>& result,
+                                     double max_error) const {
+    const Segment segment {
+        circle.position().x(),
+        circle.position().y(),
+        final_position.x() - circle.position().x(),
+        final_position.y() - circle.position().y(),
+        circle.radius(),
+    };
+
+    result.resize(size());
+
+    const auto vectorized = strategy::has_intersection<VectorOps>(segment, x_.data(), y_.data(),
+        final_x_.data(), final_y_.data(), radius_.data(), 0, size(), max_error, result.data());
+
+    strategy::has_intersection<ScalarOps>(segment, x_.data(), y_.data(),
+        final_x_.data(), final_y_.data(), radius_.data(), vectorized, size(), max_error, result.data());
+}
+
+}
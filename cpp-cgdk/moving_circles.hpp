@@ -0,0 +1,34 @@
+#pragma once
+
+#include "circle.hpp"
+
+#include <vector>
+
+namespace strategy {
+
+class MovingCircles {
+public:
+    std::size_t size() const {
+        return radius_.size();
+    }
+
+    bool empty() const {
+        return radius_.empty();
+    }
+
+    void clear();
+    void reserve(std::size_t size);
+    void add(const Circle& circle, const Point& final_position);
+
+    void has_intersection(const Circle& circle, const Point& final_position, std::vector<char>& result,
+                          double max_error = 1e-8) const;
+
+private:
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> final_x_;
+    std::vector<double> final_y_;
+    std::vector<double> radius_;
+};
+
+}
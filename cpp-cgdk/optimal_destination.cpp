@@ -13,90 +13,8 @@
 
 namespace strategy {
 
-TowersOrder::TowersOrder(const model::World& world, model::Faction faction)
-    : faction_(faction),
-      friend_towers_({{
-        {{Point(1370.66, 3650),
-          Point(2312.13, 3950)}}, // TOP
-        {{Point(902.613, 2768.1),
-          Point(1929.29, 2400)}}, // MIDDLE
-        {{Point(50, 2693.26),
-          Point(350, 1656.75)}}, // BOTTOM
-      }}),
-      enemy_towers_({{
-        {{Point(world.getWidth() - 1370.66, world.getHeight() - 3650),
-          Point(world.getWidth() - 2312.13, world.getHeight() - 3950)}}, // TOP
-        {{Point(world.getWidth() - 902.613, world.getHeight() - 2768.1),
-          Point(world.getWidth() - 1929.29, world.getHeight() - 2400)}}, // MIDDLE
-        {{Point(world.getWidth() - 50, world.getHeight() - 2693.26),
-          Point(world.getWidth() - 350, world.getHeight() - 1656.75)}}, // BOTTOM
-      }}) {
-}
-
-model::LaneType TowersOrder::get_lane(const model::Building& unit) const {
-    if (unit.getFaction() == faction_) {
-        return get_lane(unit, friend_towers_);
-    } else {
-        return get_lane(unit, enemy_towers_);
-    }
-}
-
-TowerNumber TowersOrder::get_number(const model::Building& unit) const {
-    const auto lane = get_lane(unit);
-    if (unit.getFaction() == faction_) {
-        return get_number(unit, friend_towers_[lane]);
-    } else {
-        return get_number(unit, enemy_towers_[lane]);
-    }
-}
-
-const Point& TowersOrder::get_enemy_tower(model::LaneType lane, TowerNumber number) const {
-    return enemy_towers_[lane][std::size_t(number)];
-}
-
-model::LaneType TowersOrder::get_lane(const model::Building& unit, const std::array<std::array<Point, 2>, 3>& towers) const {
-    const auto lane = std::find_if(towers.begin(), towers.end(),
-        [&] (const auto& v) { return this->get_number(unit, v) != TowerNumber::UNKNOWN; });
-    if (lane == towers.end()) {
-        std::ostringstream error;
-        error << "Lane not found for tower with id " << unit.getId()
-              << " in " << __PRETTY_FUNCTION__ << " at " << __FILE__ << ":" << __LINE__;
-        throw std::logic_error(error.str());
-    }
-    return model::LaneType(lane - towers.begin());
-}
-
-TowerNumber TowersOrder::get_number(const model::Building& unit, const std::array<Point, 2>& towers) const {
-    const auto number = std::find_if(towers.begin(), towers.end(),
-        [&] (const auto& v) { return get_position(unit).distance(v) < 100; });
-    return number == towers.end() ? TowerNumber::UNKNOWN : TowerNumber(number - towers.begin());
-}
-
 bool is_immortal(const Context& context, const model::Building& unit) {
-    const TowersOrder tower_order(context.world(), context.self().getFaction());
-    bool result = true;
-
-    const auto is_tower_exists = [&] (const auto& position) {
-        const auto& buildings = get_units<model::Building>(context.cache());
-        return buildings.end() != std::find_if(buildings.begin(), buildings.end(),
-            [&] (const auto& v) { return get_position(v.second.value()).distance(position) < 100; });
-    };
-
-    if (unit.getType() == model::BUILDING_FACTION_BASE) {
-        const auto lanes = {model::LANE_TOP, model::LANE_MIDDLE, model::LANE_BOTTOM};
-        result = lanes.end() == std::find_if_not(lanes.begin(), lanes.end(),
-            [&] (auto lane) { return is_tower_exists(tower_order.get_enemy_tower(lane, TowerNumber::FIRST)); });
-    } else {
-        const auto lane = tower_order.get_lane(unit);
-        const auto second = tower_order.get_enemy_tower(lane, TowerNumber::SECOND);
-        if (get_position(unit).distance(second) < 100) {
-            result = false;
-        } else {
-            result = is_tower_exists(second);
-        }
-    }
-
-    return result;
+    return context.towers_state().is_immortal(unit);
 }
 
 template <class Predicate>
@@ -119,38 +37,61 @@ bool has_near_units(const Point& position, const std::vector<const T*>& units, d
         [&] (auto unit) { return position.distance(get_position(*unit)) < distance; });
 }
 
-WorldGraph::Node get_nearest_node(const WorldGraph::Nodes& nodes, const Point& position) {
-    return std::min_element(nodes.begin(), nodes.end(),
-        [&] (const auto& lhs, const auto& rhs) { return position.distance(lhs.second.position) < position.distance(rhs.second.position); })->second;
-}
-
 bool is_retreat(const Context& context) {
     const auto mean_life_change = get_units<model::Wizard>(context.cache()).at(context.self().getId()).mean_life_change_speed();
     return (mean_life_change < 0 && - context.self().getLife() / mean_life_change <= TICKS_TO_DEATH_FOR_RETREAT)
             || context.self().getLife() <= context.self().getMaxLife() / 2;
 }
 
+NodesInfo::NodesInfo(const Context& context, const WorldGraph& graph, const model::Wizard& wizard)
+        : graph_(graph),
+          wizard_id_(wizard.getId()),
+          wizard_nearest_node_(graph.get_nearest_node(get_position(wizard))),
+          nodes_(graph.nodes().size()) {
+    fill<model::Bonus>(context, wizard, get_units<model::Bonus>(context.cache()));
+    fill<model::Building>(context, wizard, get_units<model::Building>(context.cache()));
+    fill<model::Minion>(context, wizard, get_units<model::Minion>(context.cache()));
+    fill<model::Wizard>(context, wizard, get_units<model::Wizard>(context.history_cache()));
+
+    const auto paths_from_me = graph.get_shortest_paths(wizard_nearest_node_.id);
+    const auto paths_from_friend_base = graph.get_shortest_paths(graph.friend_base());
+
+    const auto reach_time = wizard.getId() == context.self().getId() ? &context.reach_time() : nullptr;
+
+    for (const auto& node : graph.nodes()) {
+        auto& node_info = nodes_[node.id];
+        node_info.path_from_me_length = paths_from_me.length(node.id);
+        if (reach_time) {
+            const auto length = std::max(node_info.path_from_me_length, reach_time->field().get_lower_bound(node.position));
+            node_info.path_from_me_length = reach_time->get_ticks_for_distance(length) * context.game().getWizardForwardSpeed();
+        }
+        node_info.path_from_me_nodes_count = paths_from_me.nodes_count(node.id);
+        node_info.path_from_friend_base_nodes_count = paths_from_friend_base.nodes_count(node.id);
+    }
+}
+
+std::shared_ptr<const NodesInfo> get_nodes_info(const Context& context, const WorldGraph& graph, const model::Wizard& wizard) {
+    const auto& cached = context.nodes_info();
+    if (cached && &cached->graph() == &graph && cached->wizard_id() == wizard.getId()) {
+        return cached;
+    }
+    auto result = std::make_shared<const NodesInfo>(context, graph, wizard);
+    if (wizard.getId() == context.self().getId()) {
+        context.nodes_info(result);
+    }
+    return result;
+}
+
 GetNodeScore::GetNodeScore(const Context &context, const WorldGraph &graph, model::LaneType target_lane, const model::Wizard& wizard)
         : context_(context),
           graph_(graph),
           target_lane_(target_lane),
           wizard_(wizard),
-          nodes_info_(graph.nodes().size()),
-          wizard_nearest_node_(get_nearest_node(graph.nodes(), get_position(wizard))) {
-    fill_nodes_info<model::Bonus>(get_units<model::Bonus>(context_.cache()));
-    fill_nodes_info<model::Building>(get_units<model::Building>(context_.cache()));
-    fill_nodes_info<model::Minion>(get_units<model::Minion>(context_.cache()));
-    fill_nodes_info<model::Wizard>(get_units<model::Wizard>(context_.history_cache()));
-
-    for (const auto& node : graph.nodes()) {
-        auto& node_info = nodes_info_[node.first];
-        node_info.path_from_me = graph.get_shortest_path(wizard_nearest_node_.id, node.first);
-        node_info.path_from_friend_base = graph.get_shortest_path(graph.friend_base(), node.first);
-    }
+          info_(get_nodes_info(context, graph, wizard)) {
 }
 
 double GetNodeScore::operator ()(const WorldGraph::Node& node) const {
-    const auto& node_info = nodes_info_.at(node.id);
+    const auto& node_info = info_->nodes().at(node.id);
 
     if (is_retreat(context_)) {
         return low_life_score(node, node_info);
@@ -160,7 +101,7 @@ double GetNodeScore::operator ()(const WorldGraph::Node& node) const {
 }
 
 double GetNodeScore::high_life_score(const WorldGraph::Node& node, const NodeInfo& node_info) const {
-    if (wizard_nearest_node_.id == node.id) {
+    if (info_->wizard_nearest_node().id == node.id) {
         return 0;
     }
 
@@ -170,7 +111,7 @@ double GetNodeScore::high_life_score(const WorldGraph::Node& node, const NodeInf
                 + node_info.enemy_towers_weight * ENEMY_TOWER_REDUCE_FACTOR
                 + node_info.enemy_base_weight * ENEMY_BASE_REDUCE_FACTOR
                 + node_info.friend_wizards_weight * FRIEND_WIZARD_REDUCE_FACTOR
-                + (1 + node_info.path_from_me.length) * PATH_LENGTH_REDUCE_FACTOR
+                + (1 + node_info.path_from_me_length) * PATH_LENGTH_REDUCE_FACTOR
             );
 
     const auto bonus_score = node_info.bonus_weight
@@ -216,7 +157,7 @@ double GetNodeScore::low_life_score(const WorldGraph::Node& node, const NodeInfo
         return - 11 * double(graph_.nodes().size());
     }
 
-    return - 10 * double(node_info.path_from_me.nodes.size()) - double(node_info.path_from_friend_base.nodes.size());
+    return - 10 * double(node_info.path_from_me_nodes_count) - double(node_info.path_from_friend_base_nodes_count);
 }
 
 double GetNodeScore::low_life_score_single(const NodeInfo& node_info) const {
@@ -246,7 +187,7 @@ double GetLaneScore::operator ()(model::LaneType lane) const {
         return node_enemy_weight(lhs) < node_enemy_weight(rhs);
     });
     const auto lane_length = get_lane_length(lane);
-    const auto to_firend_base = graph.get_shortest_path(max_enemy, graph.friend_base()).length;
+    const auto to_firend_base = graph.get_shortest_path_length(max_enemy, graph.friend_base());
     const auto factor = to_firend_base > lane_length / 2
             ? bounded_line_factor(to_firend_base, lane_length / 2, lane_length)
             : bounded_line_factor(to_firend_base, lane_length / 2, 0);
@@ -283,7 +224,7 @@ WorldGraph::Node get_optimal_destination(const Context& context, const WorldGrap
     std::vector<double> scores;
     scores.reserve(graph.nodes().size());
     std::transform(graph.nodes().begin(), graph.nodes().end(), std::back_inserter(scores),
-        [&] (const auto& v) { return get_node_score(v.second); });
+        [&] (const auto& v) { return get_node_score(v); });
     return graph.nodes().at(WorldGraph::NodeId(std::max_element(scores.begin(), scores.end()) - scores.begin()));
 }
 
@@ -3,33 +3,136 @@
 #include "world_graph.hpp"
 #include "context.hpp"
 #include "helpers.hpp"
+#include "towers_state.hpp"
+
+#include <memory>
 
 namespace strategy {
 
-enum class TowerNumber {
-    FIRST,
-    SECOND,
-    UNKNOWN,
+bool is_immortal(const Context& context, const model::Building& unit);
+
+struct NodeInfo {
+    double enemy_wizards_weight = 0;
+    double enemy_minions_weight = 0;
+    double enemy_towers_weight = 0;
+    double enemy_immortal_towers_weight = 0;
+    double friend_wizards_weight = 0;
+    double friend_minions_weight = 0;
+    double friend_towers_weight = 0;
+    double bonus_weight = 0;
+    double enemy_base_weight = 0;
+    double enemy_immortal_base_weight = 0;
+    double friend_base_weight = 0;
+    double path_from_me_length = 0;
+    std::size_t path_from_me_nodes_count = 0;
+    std::size_t path_from_friend_base_nodes_count = 0;
+
+    void add_other(const model::Unit&, double) {}
+
+    void add_other(const model::Bonus&, double weight) {
+        bonus_weight = weight;
+    }
+
+    void add_enemy(const Context&, const model::Unit&, double) {}
+
+    void add_enemy(const Context&, const model::Wizard&, double weight) {
+        enemy_wizards_weight += weight;
+    }
+
+    void add_enemy(const Context&, const model::Minion&, double weight) {
+        enemy_minions_weight += weight;
+    }
+
+    void add_enemy(const Context& context, const model::Building& unit, double weight) {
+        if (unit.getType() == model::BUILDING_FACTION_BASE) {
+            if (is_immortal(context, unit)) {
+                enemy_immortal_base_weight = weight;
+            } else {
+                enemy_base_weight = weight;
+            }
+        } else {
+            if (is_immortal(context, unit)) {
+                enemy_immortal_towers_weight += weight;
+            } else {
+                enemy_towers_weight += weight;
+            }
+        }
+    }
+
+    void add_friend(const model::Unit&, double) {}
+
+    void add_friend(const model::Wizard&, double weight) {
+        friend_wizards_weight += weight;
+    }
+
+    void add_friend(const model::Minion&, double weight) {
+        friend_minions_weight += weight;
+    }
+
+    void add_friend(const model::Building& unit, double weight) {
+        if (unit.getType() == model::BUILDING_FACTION_BASE) {
+            friend_base_weight = weight;
+        } else {
+            friend_towers_weight += weight;
+        }
+    }
 };
 
-class TowersOrder {
+class NodesInfo {
 public:
-    TowersOrder(const model::World& world, model::Faction faction);
+    NodesInfo(const Context& context, const WorldGraph& graph, const model::Wizard& wizard);
+
+    const WorldGraph& graph() const {
+        return graph_;
+    }
 
-    model::LaneType get_lane(const model::Building& unit) const;
-    TowerNumber get_number(const model::Building& unit) const;
-    const Point& get_enemy_tower(model::LaneType lane, TowerNumber number) const;
+    UnitId wizard_id() const {
+        return wizard_id_;
+    }
+
+    const WorldGraph::Node& wizard_nearest_node() const {
+        return wizard_nearest_node_;
+    }
+
+    const std::vector<NodeInfo>& nodes() const {
+        return nodes_;
+    }
 
 private:
-    model::Faction faction_;
-    std::array<std::array<Point, 2>, 3> friend_towers_;
-    std::array<std::array<Point, 2>, 3> enemy_towers_;
+    const WorldGraph& graph_;
+    UnitId wizard_id_;
+    WorldGraph::Node wizard_nearest_node_;
+    std::vector<NodeInfo> nodes_;
 
-    model::LaneType get_lane(const model::Building& unit, const std::array<std::array<Point, 2>, 3>& towers) const;
-    TowerNumber get_number(const model::Building& unit, const std::array<Point, 2>& towers) const;
+    template <class Unit>
+    void fill(const Context& context, const model::Wizard& wizard,
+              const typename std::unordered_map<UnitId, CachedUnit<Unit>>& units) {
+        const auto max_distance = 2 * wizard.getVisionRange();
+        for (const auto& v : units) {
+            const auto& unit = v.second.value();
+            const auto position = get_position(unit);
+            const auto distance_to_nearest = position.distance(graph_.get_nearest_node(position).position);
+            graph_.for_each_node(position, max_distance, [&] (const WorldGraph::Node& node) {
+                const auto distance = position.distance(node.position);
+                if (distance < max_distance) {
+                    const auto distance_weight = distance_to_nearest / (distance ? distance : 1.0);
+                    auto& node_info = nodes_[node.id];
+                    if (unit.getFaction() == model::FACTION_ACADEMY || unit.getFaction() == model::FACTION_RENEGADES) {
+                        if (unit.getFaction() == wizard.getFaction()) {
+                            node_info.add_friend(unit, distance_weight);
+                        } else {
+                            node_info.add_enemy(context, unit, distance_weight);
+                        }
+                    } else {
+                        node_info.add_other(unit, distance_weight);
+                    }
+                }
+            });
+        }
+    }
 };
 
-bool is_immortal(const Context& context, const model::Building& unit);
+std::shared_ptr<const NodesInfo> get_nodes_info(const Context& context, const WorldGraph& graph, const model::Wizard& wizard);
 
 class GetNodeScore {
 public:
@@ -45,78 +148,18 @@ public:
     static constexpr double WIZARD_DAMAGE_PROBABILITY = 0.25;
     static constexpr double WIZARD_ELIMINATION_PROBABILITY = 0.05;
 
-    struct NodeInfo {
-        double enemy_wizards_weight = 0;
-        double enemy_minions_weight = 0;
-        double enemy_towers_weight = 0;
-        double enemy_immortal_towers_weight = 0;
-        double friend_wizards_weight = 0;
-        double friend_minions_weight = 0;
-        double friend_towers_weight = 0;
-        double bonus_weight = 0;
-        double enemy_base_weight = 0;
-        double enemy_immortal_base_weight = 0;
-        double friend_base_weight = 0;
-        WorldGraph::Path path_from_me;
-        WorldGraph::Path path_from_friend_base;
-
-        void add_other(const model::Unit&, double) {}
-
-        void add_other(const model::Bonus&, double weight) {
-            bonus_weight = weight;
-        }
-
-        void add_enemy(const Context&, const model::Unit&, double) {}
-
-        void add_enemy(const Context&, const model::Wizard&, double weight) {
-            enemy_wizards_weight += weight;
-        }
-
-        void add_enemy(const Context&, const model::Minion&, double weight) {
-            enemy_minions_weight += weight;
-        }
-
-        void add_enemy(const Context& context, const model::Building& unit, double weight) {
-            if (unit.getType() == model::BUILDING_FACTION_BASE) {
-                if (is_immortal(context, unit)) {
-                    enemy_immortal_base_weight = weight;
-                } else {
-                    enemy_base_weight = weight;
-                }
-            } else {
-                if (is_immortal(context, unit)) {
-                    enemy_immortal_towers_weight += weight;
-                } else {
-                    enemy_towers_weight += weight;
-                }
-            }
-        }
-
-        void add_friend(const model::Unit&, double) {}
-
-        void add_friend(const model::Wizard&, double weight) {
-            friend_wizards_weight += weight;
-        }
-
-        void add_friend(const model::Minion&, double weight) {
-            friend_minions_weight += weight;
-        }
-
-        void add_friend(const model::Building& unit, double weight) {
-            if (unit.getType() == model::BUILDING_FACTION_BASE) {
-                friend_base_weight = weight;
-            } else {
-                friend_towers_weight += weight;
-            }
-        }
-    };
+    using NodeInfo = strategy::NodeInfo;
 
     GetNodeScore(const Context& context, const WorldGraph& graph, model::LaneType target_lane, const model::Wizard& wizard);
 
     double operator ()(const WorldGraph::Node& node) const;
 
     const std::vector<NodeInfo>& nodes_info() const {
-        return nodes_info_;
+        return info_->nodes();
+    }
+
+    const std::shared_ptr<const NodesInfo>& info() const {
+        return info_;
     }
 
     int get_tower_number(const model::Building& unit) const;
@@ -126,33 +169,7 @@ private:
     const WorldGraph& graph_;
     model::LaneType target_lane_;
     const model::Wizard& wizard_;
-    std::vector<NodeInfo> nodes_info_;
-    WorldGraph::Node wizard_nearest_node_;
-
-    template <class Unit>
-    void fill_nodes_info(const typename std::unordered_map<UnitId, CachedUnit<Unit>>& units) {
-        for (const auto& v : units) {
-            const auto& unit = v.second.value();
-            const auto nearest_node = get_nearest_node(graph_.nodes(), get_position(unit));
-            const auto distance_to_nearest = get_position(unit).distance(nearest_node.position);
-            for (const auto& node : graph_.nodes()) {
-                const auto distance = get_position(unit).distance(node.second.position);
-                if (distance < 2 * wizard_.getVisionRange()) {
-                    const auto distance_weight = distance_to_nearest / (distance ? distance : 1.0);
-                    auto& node_info = nodes_info_[node.first];
-                    if (unit.getFaction() == model::FACTION_ACADEMY || unit.getFaction() == model::FACTION_RENEGADES) {
-                        if (unit.getFaction() == wizard_.getFaction()) {
-                            node_info.add_friend(unit, distance_weight);
-                        } else {
-                            node_info.add_enemy(context_, unit, distance_weight);
-                        }
-                    } else {
-                        node_info.add_other(unit, distance_weight);
-                    }
-                }
-            }
-        }
-    }
+    std::shared_ptr<const NodesInfo> info_;
 
     double high_life_score(const WorldGraph::Node& node, const NodeInfo& node_info) const;
     double low_life_score(const WorldGraph::Node& node, const NodeInfo& node_info) const;
@@ -168,7 +185,6 @@ struct GetLaneScore {
     double get_lane_length(model::LaneType lane) const;
 };
 
-WorldGraph::Node get_nearest_node(const WorldGraph::Nodes& nodes, const Point& position);
 std::array<double, model::_LANE_COUNT_> get_lanes_scores(const Context& context, const WorldGraph& graph, const model::Wizard& wizard);
 WorldGraph::Node get_optimal_destination(const Context& context, const WorldGraph& graph, model::LaneType target_lane, const model::Wizard& wizard);
 
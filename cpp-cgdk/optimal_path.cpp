@@ -2,10 +2,7 @@
 #include "optimal_position.hpp"
 #include "line.hpp"
 
-#include <set>
 #include <map>
-#include <queue>
-#include <unordered_map>
 
 #ifdef ELSID_STRATEGY_DEBUG
 
@@ -28,14 +25,73 @@ bool has_intersection_with_borders(const Circle& circle, double map_size) {
     return left <= delta || top <= delta || right <= delta || bottom <= delta;
 }
 
+PathBarriers::PathBarriers()
+        : static_barriers_({}, OPTIMAL_PATH_STATIC_BARRIERS_CELL_SIZE) {
+}
+
+PathBarriers::PathBarriers(const Context& context)
+        : static_barriers_({}, OPTIMAL_PATH_STATIC_BARRIERS_CELL_SIZE) {
+    const IsInMyRange is_projectile_in_my_range {context, context.self().getVisionRange()};
+    const IsInMyRange is_in_my_range {context, context.self().getVisionRange()};
+
+    const auto initial_projectiles_filter = [&] (const auto& units) {
+        return filter_units(units, [&] (const auto& unit) { return is_projectile_in_my_range(unit); });
+    };
+
+    const auto initial_filter = [&] (const auto& units) {
+        return filter_units(units, [&] (const auto& unit) { return !is_me(unit) && is_in_my_range(unit); });
+    };
+
+    const auto projectiles = initial_projectiles_filter(context.world().getProjectiles());
+    const auto minions = initial_filter(context.world().getMinions());
+    const auto wizards = initial_filter(context.world().getWizards());
+
+    const auto add_dynamic_barriers = [&] (const auto& units) {
+        for (const auto unit : units) {
+            dynamic_barriers_.add(get_position(*unit), get_speed(*unit), unit->getRadius());
+        }
+    };
+
+    dynamic_barriers_.reserve(projectiles.size() + minions.size() + wizards.size());
+    add_dynamic_barriers(projectiles);
+    add_dynamic_barriers(minions);
+    add_dynamic_barriers(wizards);
+
+    const auto buildings = initial_filter(context.world().getBuildings());
+    const auto trees = initial_filter(context.world().getTrees());
+
+    std::vector<Circle> circles;
+    circles.reserve(buildings.size() + trees.size());
+    std::transform(buildings.begin(), buildings.end(), std::back_inserter(circles), make_circle);
+    std::transform(trees.begin(), trees.end(), std::back_inserter(circles), make_circle);
+    static_barriers_ = CirclesGrid(std::move(circles), OPTIMAL_PATH_STATIC_BARRIERS_CELL_SIZE);
+}
+
+const PathBarriers& get_path_barriers(const Context& context, PathSearchStorage& storage) {
+    const auto position = get_position(context.self());
+
+    if (storage.path_barriers_tick != context.world().getTickIndex() || storage.path_barriers_position != position) {
+        storage.path_barriers = PathBarriers(context);
+        storage.path_barriers_tick = context.world().getTickIndex();
+        storage.path_barriers_position = position;
+        storage.closest_static_barriers.clear();
+    }
+
+    return storage.path_barriers;
+}
+
 class GetOptimalPathImpl {
 public:
-    GetOptimalPathImpl(const Context& context, const Point& target, double step_size, Tick max_ticks, std::size_t max_iterations);
+    GetOptimalPathImpl(const Context& context, const PathBarriers& path_barriers, const Point& source, double initial_tick, const Point& target,
+                       double step_size, Tick max_ticks, std::size_t max_iterations, PathSearchStorage& storage,
+                       const TangentGraph* tangent_graph, const Path* previous_path, bool anytime,
+                       Duration anytime_time_budget, const Corridor* corridor, const FlowField* flow_field);
 
     Path operator ()();
+    bool is_valid(const Path& path);
 
-    const std::unordered_map<int, TickState>& get_ticks_states() const {
-        return ticks_states;
+    const DynamicBarriersMotion& get_dynamic_barriers() const {
+        return dynamic_barriers;
     }
 
     const std::vector<StepState>& get_steps_states() const {
@@ -43,117 +99,99 @@ public:
     }
 
 private:
+    using NodeIndex = PathSearchStorage::NodeIndex;
+
     struct GreaterByPriority {
-        bool operator ()(const StepState& lhs, const StepState& rhs) const {
-            return lhs.priority() > rhs.priority();
+        const std::vector<StepState>& steps;
+
+        bool operator ()(NodeIndex lhs, NodeIndex rhs) const {
+            return steps[lhs].priority() > steps[rhs].priority();
         }
     };
 
-    using Queue = std::priority_queue<StepState, std::deque<StepState>, GreaterByPriority>;
-
     const Context& context;
+    const PathBarriers& path_barriers;
+    const Point initial_position;
+    const double initial_tick;
     const Point target;
     const double step_size;
     const Tick max_ticks;
     const std::size_t max_iterations;
-    const Point initial_position = get_position(context.self());
-    const double max_range = context.self().getVisionRange();
+    PathSearchStorage& storage;
+    const TangentGraph* tangent_graph;
+    const Path* previous_path;
+    const bool anytime;
+    const Duration anytime_time_budget;
+    const Corridor* const corridor;
+    const FlowField* flow_field;
+    double weight = 1;
+    bool in_corridor = false;
     const double speed = (context.game().getWizardForwardSpeed() + context.game().getWizardBackwardSpeed()
                           + 2 * context.game().getWizardStrafeSpeed()) / 4;
 
-    std::vector<const model::Projectile*> projectiles;
-    std::vector<const model::Minion*> minions;
-    std::vector<const model::Wizard*> wizards;
-
-    std::vector<Circle> static_barriers;
-
-    std::unordered_map<int, TickState> ticks_states;
+    const DynamicBarriersMotion& dynamic_barriers;
+    const CirclesGrid& static_barriers;
     std::vector<StepState> steps_states;
 
-    Queue queue;
-    std::map<PointInt, double> costs;
-    std::set<std::pair<PointInt, PointInt>> pushed;
-    std::map<Point, StepState> came_from;
+    std::vector<StepState>& steps;
+    std::vector<NodeIndex>& queue;
+    std::vector<StepState>& inconsistent;
+    FlatHashMap<PointInt, double>& costs;
+    FlatHashSet<std::pair<PointInt, PointInt>, PointsPairHash>& pushed;
+    FlatHashMap<Point, NodeIndex>& came_from;
+    FlatHashSet<Point>& visited;
+    std::vector<std::size_t>& barriers;
+    MovingCircles& candidates;
+    std::vector<char>& intersections;
+    FlatHashMap<std::pair<Point, Point>, std::size_t, PointsPairHash>& closest_static_barriers;
 
-    TickState make_tick_state(double prev_tick, double tick) const;
-    const TickState& get_tick_state(double prev_tick, double tick);
     double get_priority(const Point& position) const;
+    double get_step_priority(const StepState& step_state) const;
     double get_tentative_cost(const StepState& step_state, const Point& target) const;
     double get_next_tick(const StepState& step_state, const Point& next_position) const;
-    Path reconstruct_path(Point position, const std::map<Point, StepState>& came_from) const;
-    void fill_steps_states(StepState step_state, const std::map<Point, StepState>& came_from);
+    Path reconstruct_path(Point position);
+    void fill_steps_states(StepState step_state);
+    void push(const StepState& step_state);
+    NodeIndex pop();
     Point adjust_target(const Point& position, const Point& target) const;
     void add_state(const StepState& step_state, const Point& next_target);
-    const Circle* get_closest_dynamic_barrier(const StepState& step_state);
+    const Circle* get_closest_static_barrier(const StepState& step_state);
+    std::pair<bool, Circle> get_closest_dynamic_barrier(const StepState& step_state) const;
+    std::size_t get_first_invalid_segment(const Path& path);
+    bool get_tangent_graph_path(Path& result);
+    bool repair_previous_path(Path& result);
+    bool is_cost_near_lower_bound() const;
+    StepState search(Duration time_budget, bool resume);
+    Duration get_time_budget() const;
+    StepState bounded_search(Duration time_budget);
+    Path anytime_search();
+    void reweight(double value);
 };
 
-GetOptimalPathImpl::GetOptimalPathImpl(const Context& context, const Point& target, double step_size, Tick max_ticks, std::size_t max_iterations)
-        : context(context), target(target), step_size(step_size), max_ticks(max_ticks), max_iterations(max_iterations) {
-    const IsInMyRange is_projectile_in_my_range {context, context.self().getVisionRange()};
-    const IsInMyRange is_in_my_range {context, max_range};
-
-    const auto initial_projectiles_filter = [&] (const auto& units) {
-        return filter_units(units, [&] (const auto& unit) { return is_projectile_in_my_range(unit); });
-    };
-
-    const auto initial_filter = [&] (const auto& units) {
-        return filter_units(units, [&] (const auto& unit) { return !is_me(unit) && is_in_my_range(unit); });
-    };
-
-    projectiles = initial_projectiles_filter(context.world().getProjectiles());
-    minions = initial_filter(context.world().getMinions());
-    wizards = initial_filter(context.world().getWizards());
-
-    const auto buildings = initial_filter(context.world().getBuildings());
-    const auto trees = initial_filter(context.world().getTrees());
-
-    static_barriers.reserve(buildings.size() + trees.size());
-    std::transform(buildings.begin(), buildings.end(), std::back_inserter(static_barriers), make_circle);
-    std::transform(trees.begin(), trees.end(), std::back_inserter(static_barriers), make_circle);
-    ticks_states.insert({0, make_tick_state(0, 0)});
-}
-
-TickState GetOptimalPathImpl::make_tick_state(double prev_tick, double tick) const {
-    const auto make = [&] (auto unit) {
-        return DynamicBarrier {
-            std::size_t(unit),
-            Circle(get_position(*unit) + get_speed(*unit) * prev_tick, unit->getRadius()),
-            get_position(*unit) + get_speed(*unit) * tick,
-        };
-    };
-
-    DynamicBarriers dynamic_barriers;
-    dynamic_barriers.reserve(projectiles.size() + minions.size() + wizards.size());
-    std::transform(projectiles.begin(), projectiles.end(), std::back_inserter(dynamic_barriers), make);
-    std::transform(minions.begin(), minions.end(), std::back_inserter(dynamic_barriers), make);
-    std::transform(wizards.begin(), wizards.end(), std::back_inserter(dynamic_barriers), make);
-
-    const Circle barrier(get_position(context.self()), context.self().getRadius());
-
-    TickState::Occupier occupier;
-    const auto static_occupier = std::find_if(static_barriers.begin(), static_barriers.end(),
-        [&] (const auto& v) { return v.position().distance(target) <= v.radius() + barrier.radius(); });
-    if (static_occupier != static_barriers.end()) {
-        occupier = {true, *static_occupier};
-    } else {
-        const auto dynamic_occupier = std::find_if(dynamic_barriers.begin(), dynamic_barriers.end(),
-            [&] (const auto& v) { return v.target.distance(target) <= v.circle.radius() + barrier.radius(); });
-        if (dynamic_occupier != dynamic_barriers.end()) {
-            occupier = {true, dynamic_occupier->circle};
-        }
-    }
-
-    const auto max_distance_error = occupier.first ? occupier.second.radius() + barrier.radius() + 1 : 1;
-
-    return TickState(std::move(dynamic_barriers), occupier, max_distance_error);
+GetOptimalPathImpl::GetOptimalPathImpl(const Context& context, const PathBarriers& path_barriers, const Point& source,
+                                       double initial_tick, const Point& target,
+                                       double step_size, Tick max_ticks, std::size_t max_iterations, PathSearchStorage& storage,
+                                       const TangentGraph* tangent_graph, const Path* previous_path, bool anytime,
+                                       Duration anytime_time_budget, const Corridor* corridor, const FlowField* flow_field)
+        : context(context), path_barriers(path_barriers), initial_position(source), initial_tick(initial_tick), target(target),
+          step_size(step_size), max_ticks(max_ticks), max_iterations(max_iterations), storage(storage),
+          tangent_graph(tangent_graph), previous_path(previous_path), anytime(anytime),
+          anytime_time_budget(anytime_time_budget), corridor(corridor), flow_field(flow_field),
+          dynamic_barriers(path_barriers.dynamic_barriers()), static_barriers(path_barriers.static_barriers()),
+          steps(storage.steps), queue(storage.queue), inconsistent(storage.inconsistent), costs(storage.costs),
+          pushed(storage.pushed),
+          came_from(storage.came_from), visited(storage.visited), barriers(storage.barriers),
+          candidates(storage.candidates), intersections(storage.intersections),
+          closest_static_barriers(storage.closest_static_barriers) {
 }
 
-const TickState& GetOptimalPathImpl::get_tick_state(double prev_tick, double tick) {
-    auto tick_state = ticks_states.find(std::round(tick));
-    if (tick_state == ticks_states.end()) {
-        tick_state = ticks_states.insert({std::round(tick), make_tick_state(prev_tick, tick)}).first;
+DynamicBarriers DynamicBarriersMotion::snapshot(double prev_tick, double tick) const {
+    DynamicBarriers result;
+    result.reserve(size());
+    for (std::size_t index = 0; index < size(); ++index) {
+        result.push_back(DynamicBarrier {index, circle(index, prev_tick), position(index, tick)});
     }
-    return tick_state->second;
+    return result;
 }
 
 double GetOptimalPathImpl::get_next_tick(const StepState& step_state, const Point& next_position) const {
@@ -162,7 +200,15 @@ double GetOptimalPathImpl::get_next_tick(const StepState& step_state, const Poin
 }
 
 double GetOptimalPathImpl::get_priority(const Point& position) const {
-    return target.distance(position);
+    const auto distance = target.distance(position);
+    return flow_field ? std::max(distance, flow_field->get_lower_bound(position)) : distance;
+}
+
+double GetOptimalPathImpl::get_step_priority(const StepState& step_state) const {
+    if (step_state.target() == target) {
+        return step_state.cost() + weight * get_priority(step_state.position());
+    }
+    return get_tentative_cost(step_state, step_state.target()) + weight * get_priority(step_state.target());
 }
 
 double GetOptimalPathImpl::get_tentative_cost(const StepState& step_state, const Point& target) const {
@@ -170,43 +216,56 @@ double GetOptimalPathImpl::get_tentative_cost(const StepState& step_state, const
     return step_state.cost() + distance;
 }
 
-Path GetOptimalPathImpl::reconstruct_path(Point position, const std::map<Point, StepState>& came_from) const {
+Path GetOptimalPathImpl::reconstruct_path(Point position) {
     Path result;
-    std::set<Point> visited;
+    visited.clear();
     result.reserve(came_from.size());
     while (true) {
-        if (!visited.insert(position).second) {
+        if (!visited.insert(position)) {
             break;
         }
         result.push_back(position);
         const auto prev = came_from.find(position);
-        if (prev == came_from.end()) {
+        if (!prev) {
             break;
         }
-        position = prev->second.position();
+        position = steps[*prev].position();
     }
     std::reverse(result.begin(), result.end());
     return result;
 }
 
-void GetOptimalPathImpl::fill_steps_states(StepState step_state, const std::map<Point, StepState>& came_from) {
+void GetOptimalPathImpl::fill_steps_states(StepState step_state) {
     steps_states.clear();
     steps_states.reserve(came_from.size());
-    std::set<Point> visited;
+    visited.clear();
     while (true) {
-        if (!visited.insert(step_state.position()).second) {
+        if (!visited.insert(step_state.position())) {
             break;
         }
         steps_states.push_back(step_state);
         const auto prev = came_from.find(step_state.position());
-        if (prev == came_from.end()) {
+        if (!prev) {
             break;
         }
-        step_state = prev->second;
+        step_state = steps[*prev];
     }
     std::reverse(steps_states.begin(), steps_states.end());
 }
 
+void GetOptimalPathImpl::push(const StepState& step_state) {
+    queue.push_back(NodeIndex(steps.size()));
+    steps.push_back(step_state);
+    std::push_heap(queue.begin(), queue.end(), GreaterByPriority {steps});
+}
+
+GetOptimalPathImpl::NodeIndex GetOptimalPathImpl::pop() {
+    std::pop_heap(queue.begin(), queue.end(), GreaterByPriority {steps});
+    const auto result = queue.back();
+    queue.pop_back();
+    return result;
+}
+
 std::pair<Point, Point> get_tangent_points(const Circle& circle, const Point& source) {
     const auto hypot = circle.position().distance(source);
     const auto far_cathetus = circle.radius();
@@ -236,58 +295,83 @@ void GetOptimalPathImpl::add_state(const StepState& step_state, const Point& nex
         return;
     }
 
+    if (in_corridor && !corridor->contains(step_state.position(), next_target)) {
+        return;
+    }
+
     const auto other = costs.find(next_target.to_int());
     const auto tentative_cost = get_tentative_cost(step_state, next_target);
 
-    if (other != costs.end() && other->second <= tentative_cost) {
+    if (other && *other <= tentative_cost) {
         return;
     }
 
-    if (pushed.insert({step_state.position().to_int(), next_target.to_int()}).second) {
-        const auto priority = tentative_cost + get_priority(next_target);
-        queue.push(StepState(priority, step_state.cost(), step_state.tick(), step_state.position(), next_target));
+    const auto priority = tentative_cost + weight * get_priority(next_target);
+    const StepState next_state(priority, step_state.cost(), step_state.tick(), step_state.position(), next_target);
+
+    if (pushed.insert({step_state.position().to_int(), next_target.to_int()})) {
+        push(next_state);
+    } else if (anytime) {
+        inconsistent.push_back(next_state);
     }
 }
 
-std::vector<Circle>::const_iterator get_closest_barrier(const Circle& my_barrier, const Point& target, const std::vector<Circle>& static_barriers) {
-    auto closest = static_barriers.end();
+const Circle* GetOptimalPathImpl::get_closest_static_barrier(const StepState& step_state) {
+    const auto key = std::make_pair(step_state.position(), step_state.target());
+
+    if (const auto cached = closest_static_barriers.find(key)) {
+        return *cached < static_barriers.circles().size() ? &static_barriers.circles()[*cached] : nullptr;
+    }
+
+    const Circle my_barrier(step_state.position(), context.self().getRadius());
+    std::size_t closest = static_barriers.circles().size();
     double closest_distance = std::numeric_limits<double>::max();
-    for (auto barrier = static_barriers.begin(); barrier != static_barriers.end(); ++barrier) {
-        if (barrier->has_intersection(my_barrier, target)) {
-            const auto distance = barrier->position().distance(my_barrier.position());
+    static_barriers.find_candidates(my_barrier, step_state.target(), barriers);
+    candidates.clear();
+    for (const auto index : barriers) {
+        const auto& barrier = static_barriers.circles()[index];
+        candidates.add(barrier, barrier.position());
+    }
+    candidates.has_intersection(my_barrier, step_state.target(), intersections);
+    for (std::size_t i = 0; i < barriers.size(); ++i) {
+        const auto& barrier = static_barriers.circles()[barriers[i]];
+        if (intersections[i]) {
+            const auto distance = barrier.position().distance(my_barrier.position());
             if (closest_distance > distance) {
-                closest = barrier;
+                closest = barriers[i];
                 closest_distance = distance;
             }
         }
     }
-    return closest;
+    closest_static_barriers.insert(key, closest);
+    return closest < static_barriers.circles().size() ? &static_barriers.circles()[closest] : nullptr;
 }
 
-const Circle* GetOptimalPathImpl::get_closest_dynamic_barrier(const StepState& step_state) {
-    const auto& tick_state = get_tick_state(step_state.tick(), get_next_tick(step_state, step_state.target()));
-    const auto& dynamic_barriers = tick_state.dynamic_barriers();
-    const Circle* result = nullptr;
+std::pair<bool, Circle> GetOptimalPathImpl::get_closest_dynamic_barrier(const StepState& step_state) const {
+    const auto next_tick = get_next_tick(step_state, step_state.target());
+    const Circle my_barrier(step_state.position(), context.self().getRadius());
+    std::pair<bool, Circle> result(false, Circle());
     double closest_distance = std::numeric_limits<double>::max();
 
-    for (auto barrier = dynamic_barriers.begin(); barrier != dynamic_barriers.end(); ++barrier) {
-        const Circle my_barrier(step_state.position(), context.self().getRadius());
+    for (std::size_t index = 0; index < dynamic_barriers.size(); ++index) {
+        const auto barrier = dynamic_barriers.circle(index, step_state.tick());
+        const auto barrier_target = dynamic_barriers.position(index, next_tick);
 
-        if (!barrier->circle.has_intersection(barrier->target, my_barrier, step_state.target())) {
+        if (!barrier.has_intersection(barrier_target, my_barrier, step_state.target())) {
             continue;
         }
 
-        if (barrier->circle.position() == barrier->target) {
-            const auto distance = step_state.position().distance(barrier->target);
+        if (barrier.position() == barrier_target) {
+            const auto distance = step_state.position().distance(barrier_target);
             if (closest_distance > distance) {
                 closest_distance = distance;
-                result = &barrier->circle;
+                result = {true, barrier};
             }
             continue;
         }
 
         const Line my_trajectory(my_barrier.position(), target);
-        const Line dynamic_barrier_trajectory(barrier->circle.position(), barrier->target);
+        const Line dynamic_barrier_trajectory(barrier.position(), barrier_target);
         bool has_intersection;
         Point intersection;
         std::tie(has_intersection, intersection) = my_trajectory.intersection(dynamic_barrier_trajectory);
@@ -298,56 +382,253 @@ const Circle* GetOptimalPathImpl::get_closest_dynamic_barrier(const StepState& s
 
         const auto distance = step_state.position().distance(intersection);
         const auto ticks_to_intersection = distance / speed;
-        const auto tick = step_state.tick() + ticks_to_intersection;
-        const auto& ticks_state = get_tick_state(step_state.tick(), tick);
-        const auto& dynamic_barriers = ticks_state.dynamic_barriers();
-        const auto barrier_at_tick = std::find_if(dynamic_barriers.begin(), dynamic_barriers.end(),
-            [&] (const auto& v) { return v.id == barrier->id; });
-
-        if (barrier_at_tick == dynamic_barriers.end()) {
-            continue;
-        }
-
         const auto to_target = (step_state.target() - step_state.position()).normalized();
         const auto my_position_at_tick = step_state.position() + ticks_to_intersection * speed * to_target;
         const Circle my_barrier_at_tick(my_position_at_tick, my_barrier.radius());
+        const auto barrier_at_tick = dynamic_barriers.circle(index, step_state.tick() + ticks_to_intersection);
 
-        if (!barrier_at_tick->circle.has_intersection(my_barrier_at_tick)) {
+        if (!barrier.has_intersection(my_barrier_at_tick) && !barrier_at_tick.has_intersection(my_barrier_at_tick)) {
             continue;
         }
 
         if (closest_distance > distance) {
             closest_distance = distance;
-            result = &barrier_at_tick->circle;
+            result = {true, barrier};
         }
     }
 
     return result;
 }
 
+std::size_t GetOptimalPathImpl::get_first_invalid_segment(const Path& path) {
+    steps_states.clear();
+    steps_states.reserve(path.size());
+
+    double cost = 0;
+    double tick = initial_tick;
+
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        const StepState step_state(cost + get_priority(path[i - 1]), cost, tick, path[i - 1], path[i]);
+
+        if (step_state.tick() <= max_ticks
+                && (get_closest_static_barrier(step_state) || get_closest_dynamic_barrier(step_state).first)) {
+            return i - 1;
+        }
+
+        steps_states.push_back(step_state);
+        cost = get_tentative_cost(step_state, path[i]);
+        tick = get_next_tick(step_state, path[i]);
+    }
+
+    steps_states.push_back(StepState(cost, cost, tick, path.back(), target));
+
+    return path.size() - 1;
+}
+
+bool GetOptimalPathImpl::get_tangent_graph_path(Path& result) {
+    result = tangent_graph->get_path(initial_position, target);
+    return result.size() >= 2 && get_first_invalid_segment(result) == result.size() - 1;
+}
+
+bool GetOptimalPathImpl::repair_previous_path(Path& result) {
+    const auto& previous = *previous_path;
+
+    if (previous.size() < 2 || previous.back() != target) {
+        return false;
+    }
+
+    result = get_remaining_path(previous, initial_position);
+
+    if (result.size() < 2) {
+        return false;
+    }
+
+    const auto broken = get_first_invalid_segment(result);
+
+    if (broken == result.size() - 1) {
+        return is_cost_near_lower_bound();
+    }
+
+    const auto tick = broken == 0 ? initial_tick : get_next_tick(steps_states.back(), result[broken]);
+    const auto detour = GetOptimalPathImpl(context, path_barriers, result[broken], tick, result[broken + 1], step_size,
+                                           max_ticks, max_iterations, storage, nullptr, nullptr, false, Duration::max(),
+                                           nullptr, nullptr)();
+
+    if (detour.empty() || detour.back() != result[broken + 1]) {
+        return false;
+    }
+
+    Path repaired(result.begin(), result.begin() + broken);
+    repaired.insert(repaired.end(), detour.begin(), detour.end());
+    repaired.insert(repaired.end(), result.begin() + broken + 2, result.end());
+
+    if (get_first_invalid_segment(repaired) != repaired.size() - 1) {
+        return false;
+    }
+
+    result = std::move(repaired);
+
+    return is_cost_near_lower_bound();
+}
+
+bool GetOptimalPathImpl::is_cost_near_lower_bound() const {
+    return steps_states.back().cost() <= OPTIMAL_PATH_REPAIR_MAX_COST_RATIO * get_priority(initial_position);
+}
+
+bool GetOptimalPathImpl::is_valid(const Path& path) {
+    return path.size() < 2 || get_first_invalid_segment(path) == path.size() - 1;
+}
+
 Path GetOptimalPathImpl::operator ()() {
+    if (previous_path && initial_position != target) {
+        Path result;
+        if (repair_previous_path(result)) {
+            return result;
+        }
+    }
+
+    if (tangent_graph && initial_position != target) {
+        Path result;
+        if (get_tangent_graph_path(result)) {
+            return result;
+        }
+    }
+
+    if (anytime) {
+        return anytime_search();
+    }
+
+    const auto final_state = bounded_search(get_time_budget());
+
+    fill_steps_states(final_state);
+
+    return reconstruct_path(final_state.position());
+}
+
+Path GetOptimalPathImpl::anytime_search() {
+    Path result;
+    std::vector<StepState> result_steps_states;
+    StepState result_state;
+    bool has_result = false;
+    const auto start = Clock::now();
+    const auto time_budget = std::min(anytime_time_budget, get_time_budget());
+    const auto is_bounded = time_budget != Duration::max();
+
+    weight = OPTIMAL_PATH_ANYTIME_INITIAL_WEIGHT;
+
+    while (true) {
+        const auto run_start = Clock::now();
+        const auto time_left = is_bounded ? time_budget - Duration(run_start - start) : time_budget;
+        const auto final_state = has_result ? search(time_left, true) : bounded_search(time_left);
+        const auto is_complete = final_state.position() == target;
+        const auto is_result_complete = has_result && result_state.position() == target;
+
+        if (!has_result
+                || (is_complete && (!is_result_complete || final_state.cost() < result_state.cost()))
+                || (!is_complete && !is_result_complete
+                    && get_priority(final_state.position()) < get_priority(result_state.position()))) {
+            fill_steps_states(final_state);
+            result = reconstruct_path(final_state.position());
+            result_steps_states = steps_states;
+            result_state = final_state;
+            has_result = true;
+        }
+
+        if (weight - OPTIMAL_PATH_ANYTIME_WEIGHT_DECREASE < 1) {
+            break;
+        }
+
+        const auto finish = Clock::now();
+
+        if (Duration(finish - start) + Duration(finish - run_start) > time_budget) {
+            break;
+        }
+
+        reweight(weight - OPTIMAL_PATH_ANYTIME_WEIGHT_DECREASE);
+    }
+
+    weight = 1;
+    steps_states = std::move(result_steps_states);
+
+    return result;
+}
+
+void GetOptimalPathImpl::reweight(double value) {
+    weight = value;
+    pushed.clear();
+
+    for (const auto& step_state : inconsistent) {
+        queue.push_back(NodeIndex(steps.size()));
+        steps.push_back(step_state);
+    }
+
+    inconsistent.clear();
+
+    for (const auto index : queue) {
+        const auto step_state = steps[index];
+        pushed.insert({step_state.position().to_int(), step_state.target().to_int()});
+        steps[index] = StepState(get_step_priority(step_state), step_state.cost(), step_state.tick(),
+                                 step_state.position(), step_state.target());
+    }
+
+    std::make_heap(queue.begin(), queue.end(), GreaterByPriority {steps});
+}
+
+StepState GetOptimalPathImpl::bounded_search(Duration time_budget) {
+    in_corridor = corridor != nullptr;
+
+    if (!in_corridor) {
+        return search(time_budget, false);
+    }
+
+    const auto is_bounded = time_budget != Duration::max();
+    const auto start = Clock::now();
+    const auto result = search(is_bounded ? OPTIMAL_PATH_CORRIDOR_TIME_BUDGET_SHARE * time_budget : time_budget, false);
+
+    if (result.position() == target) {
+        return result;
+    }
+
+    context.check_timeout(__PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+    in_corridor = false;
+
+    return search(is_bounded ? time_budget - Duration(Clock::now() - start) : time_budget, false);
+}
+
+Duration GetOptimalPathImpl::get_time_budget() const {
+    return context.time_limit() == Duration::max()
+            ? Duration::max()
+            : context.time_left() / OPTIMAL_PATH_ANYTIME_RESERVE_FACTOR;
+}
+
+StepState GetOptimalPathImpl::search(Duration time_budget, bool resume) {
     std::size_t iterations = 0;
-    const StepState initial_state(get_priority(initial_position), 0, 0, initial_position, target);
+    const StepState initial_state(weight * get_priority(initial_position), 0, initial_tick, initial_position, target);
     auto final_state = initial_state;
     std::size_t current_max_iterations = max_iterations;
-    const auto time_limit = context.time_limit();
     Duration max_duration(0);
 
-    queue = Queue();
-    costs.clear();
-    pushed.clear();
-    came_from.clear();
-
-    queue.push(initial_state);
-    pushed.insert({initial_position.to_int(), target.to_int()});
-    costs.insert({initial_position.to_int(), 0});
+    if (!resume) {
+        steps.clear();
+        queue.clear();
+        inconsistent.clear();
+        costs.clear();
+        pushed.clear();
+        came_from.clear();
+
+        push(initial_state);
+        pushed.insert({initial_position.to_int(), target.to_int()});
+        costs.insert(initial_position.to_int(), 0);
+    }
 
     while (!queue.empty()) {
         context.check_timeout(__PRETTY_FUNCTION__, __FILE__, __LINE__);
 
         const auto iteration_start = Clock::now();
 
-        const auto step_state = queue.top();
+        const auto step_index = queue.front();
+        const auto step_state = steps[step_index];
 
         if (step_state.position() == target) {
             final_state = step_state;
@@ -358,27 +639,27 @@ Path GetOptimalPathImpl::operator ()() {
             final_state = step_state;
         }
 
-        if (++iterations > max_iterations) {
+        if (++iterations > current_max_iterations) {
             break;
         }
 
-        queue.pop();
+        pop();
 
         if (step_state.tick() > max_ticks) {
             continue;
         }
 
-        const Circle my_barrier(step_state.position(), context.self().getRadius());
-        const auto closest_static_barrier = strategy::get_closest_barrier(my_barrier, step_state.target(), static_barriers);
-        const auto closest_dynamic_barrier = get_closest_dynamic_barrier(step_state);
+        const auto closest_static_barrier = get_closest_static_barrier(step_state);
+        const auto dynamic_barrier = get_closest_dynamic_barrier(step_state);
+        const auto closest_dynamic_barrier = dynamic_barrier.first ? &dynamic_barrier.second : nullptr;
         const Circle* closest = nullptr;
 
-        if (closest_static_barrier != static_barriers.end() && closest_dynamic_barrier) {
+        if (closest_static_barrier && closest_dynamic_barrier) {
             const auto distance_to_static = closest_static_barrier->position().distance(step_state.position());
             const auto distance_to_dynamic = closest_dynamic_barrier->position().distance(step_state.position());
-            closest = distance_to_dynamic < distance_to_static ? closest_dynamic_barrier : &*closest_static_barrier;
-        } else if (closest_static_barrier != static_barriers.end()) {
-            closest = &*closest_static_barrier;
+            closest = distance_to_dynamic < distance_to_static ? closest_dynamic_barrier : closest_static_barrier;
+        } else if (closest_static_barrier) {
+            closest = closest_static_barrier;
         } else if (closest_dynamic_barrier) {
             closest = closest_dynamic_barrier;
         }
@@ -410,44 +691,58 @@ Path GetOptimalPathImpl::operator ()() {
             const auto other = costs.find(step_state.target().to_int());
             const auto cost = get_tentative_cost(step_state, step_state.target());
 
-            if (other == costs.end()) {
-                costs.insert({step_state.target().to_int(), cost});
-            } else if (other->second > step_state.cost()) {
-                other->second = cost;
+            if (!other) {
+                costs.insert(step_state.target().to_int(), cost);
+            } else if (*other > step_state.cost()) {
+                *other = cost;
             } else {
                 continue;
             }
 
-            came_from[step_state.target()] = step_state;
+            came_from[step_state.target()] = step_index;
+
+            const auto priority = cost + weight * get_priority(step_state.target());
+            const StepState next_state(priority, cost, get_next_tick(step_state, step_state.target()), step_state.target(), target);
 
-            if (pushed.insert({step_state.target().to_int(), target.to_int()}).second) {
-                const auto priority = cost + get_priority(step_state.target());
-                queue.push(StepState(priority, cost, get_next_tick(step_state, step_state.target()), step_state.target(), target));
+            if (pushed.insert({step_state.target().to_int(), target.to_int()})) {
+                push(next_state);
+            } else if (anytime) {
+                inconsistent.push_back(next_state);
             }
         }
 
-        if (max_iterations != std::numeric_limits<std::size_t>::max() && time_limit != Duration::max()) {
+        if (max_iterations != std::numeric_limits<std::size_t>::max() && time_budget != Duration::max()) {
             const auto iteration_finish = Clock::now();
             max_duration = std::max(max_duration, Duration(iteration_finish - iteration_start));
-            if (iterations > 3) {
-                const std::size_t available_iterations = std::floor(std::max(time_limit.count() - 1, 0.0) / Duration(max_duration).count());
-                current_max_iterations = std::min(current_max_iterations, available_iterations);
+            if (iterations > 3 && max_duration.count() > 0) {
+                const auto available_iterations = std::floor(std::max(time_budget.count(), 0.0) / max_duration.count());
+                if (available_iterations < double(current_max_iterations)) {
+                    current_max_iterations = std::size_t(available_iterations);
+                }
             }
         }
     }
 
-    fill_steps_states(final_state, came_from);
-
-    return reconstruct_path(final_state.position(), came_from);
+    return final_state;
 }
 
 Path GetOptimalPath::operator ()(const Context& context, const Point& target) const {
-    GetOptimalPathImpl impl(context, target, step_size_, max_ticks_, max_iterations_);
+    PathSearchStorage local_storage;
+    auto& storage = storage_ ? *storage_ : local_storage;
+    GetOptimalPathImpl impl(context, get_path_barriers(context, storage), get_position(context.self()), 0, target,
+                            step_size_, max_ticks_, max_iterations_, storage, tangent_graph_, previous_path_, anytime_,
+                            anytime_time_budget_, corridor_ && !corridor_->empty() ? corridor_ : nullptr, flow_field_);
     const auto result = impl();
 
     if (ticks_states_) {
-        const auto& src = impl.get_ticks_states();
-        std::copy(src.begin(), src.end(), std::inserter(*ticks_states_, ticks_states_->end()));
+        const auto& dynamic_barriers = impl.get_dynamic_barriers();
+        const auto& steps_states = impl.get_steps_states();
+        ticks_states_->insert({0, TickState(dynamic_barriers.snapshot(0, 0))});
+        for (std::size_t i = 1; i < steps_states.size(); ++i) {
+            const auto prev_tick = steps_states[i - 1].tick();
+            const auto tick = steps_states[i].tick();
+            ticks_states_->insert({int(std::round(tick)), TickState(dynamic_barriers.snapshot(prev_tick, tick))});
+        }
     }
 
     if (steps_states_) {
@@ -458,6 +753,57 @@ Path GetOptimalPath::operator ()(const Context& context, const Point& target) co
     return result;
 }
 
+bool IsPathValid::operator ()(const Context& context, const Path& path) const {
+    if (path.empty()) {
+        return true;
+    }
+
+    PathSearchStorage local_storage;
+    auto& storage = storage_ ? *storage_ : local_storage;
+    GetOptimalPathImpl impl(context, get_path_barriers(context, storage), path.front(), 0, path.back(), 1, max_ticks_,
+                            std::numeric_limits<std::size_t>::max(), storage, nullptr, nullptr, false, Duration::max(),
+                            nullptr, nullptr);
+
+    return impl.is_valid(path);
+}
+
+IsPathValid& IsPathValid::max_ticks(Tick value) {
+    max_ticks_ = value;
+    return *this;
+}
+
+IsPathValid& IsPathValid::storage(PathSearchStorage* value) {
+    storage_ = value;
+    return *this;
+}
+
+Path get_remaining_path(const Path& path, const Point& position) {
+    std::size_t nearest = 0;
+    double min_distance = std::numeric_limits<double>::max();
+
+    for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+        const Line segment(path[i], path[i + 1]);
+        auto point = segment.nearest(position);
+        if (!segment.has_point(point)) {
+            point = position.distance(segment.begin()) < position.distance(segment.end()) ? segment.begin() : segment.end();
+        }
+        const auto distance = position.distance(point);
+        if (min_distance > distance) {
+            min_distance = distance;
+            nearest = i;
+        }
+    }
+
+    Path result;
+    result.reserve(path.size() - nearest + 1);
+    result.push_back(position);
+    if (path.size() > 1) {
+        std::copy_if(path.begin() + nearest + 1, path.end(), std::back_inserter(result),
+            [&] (const auto& v) { return v != position; });
+    }
+    return result;
+}
+
 GetOptimalPath& GetOptimalPath::step_size(double value) {
     step_size_ = value;
     return *this;
@@ -483,4 +829,39 @@ GetOptimalPath& GetOptimalPath::steps_states(std::vector<StepState>* value) {
     return *this;
 }
 
+GetOptimalPath& GetOptimalPath::storage(PathSearchStorage* value) {
+    storage_ = value;
+    return *this;
+}
+
+GetOptimalPath& GetOptimalPath::tangent_graph(const TangentGraph* value) {
+    tangent_graph_ = value;
+    return *this;
+}
+
+GetOptimalPath& GetOptimalPath::previous_path(const Path* value) {
+    previous_path_ = value;
+    return *this;
+}
+
+GetOptimalPath& GetOptimalPath::anytime(bool value) {
+    anytime_ = value;
+    return *this;
+}
+
+GetOptimalPath& GetOptimalPath::anytime_time_budget(Duration value) {
+    anytime_time_budget_ = value;
+    return *this;
+}
+
+GetOptimalPath& GetOptimalPath::corridor(const Corridor* value) {
+    corridor_ = value;
+    return *this;
+}
+
+GetOptimalPath& GetOptimalPath::flow_field(const FlowField* value) {
+    flow_field_ = value;
+    return *this;
+}
+
 }
@@ -1,9 +1,16 @@
 #pragma once
 
 #include "circle.hpp"
+#include "circles_grid.hpp"
 #include "point.hpp"
 #include "context.hpp"
+#include "corridor.hpp"
+#include "flat_hash_map.hpp"
+#include "flow_field.hpp"
+#include "moving_circles.hpp"
+#include "tangent_graph.hpp"
 
+#include <cstdint>
 #include <map>
 #include <vector>
 
@@ -54,30 +61,122 @@ using DynamicBarriers = std::vector<DynamicBarrier>;
 
 class TickState {
 public:
-    using Occupier = std::pair<bool, Circle>;
+    TickState(DynamicBarriers dynamic_barriers)
+            : dynamic_barriers_(std::move(dynamic_barriers)) {}
 
-    TickState(DynamicBarriers dynamic_barriers,
-              const Occupier& occupier, double max_distance_error)
-            : dynamic_barriers_(std::move(dynamic_barriers)),
-              occupier_(occupier),
-              max_distance_error_(max_distance_error) {}
+    const DynamicBarriers& dynamic_barriers() const {
+        return dynamic_barriers_;
+    }
+
+private:
+    DynamicBarriers dynamic_barriers_;
+};
 
-    double max_distance_error() const {
-        return max_distance_error_;
+class DynamicBarriersMotion {
+public:
+    std::size_t size() const {
+        return radius_.size();
     }
 
-    const Occupier& occupier() const {
-        return occupier_;
+    Point position(std::size_t index, double tick) const {
+        return Point(x_[index] + speed_x_[index] * tick, y_[index] + speed_y_[index] * tick);
     }
 
-    const DynamicBarriers& dynamic_barriers() const {
+    double radius(std::size_t index) const {
+        return radius_[index];
+    }
+
+    Circle circle(std::size_t index, double tick) const {
+        return Circle(position(index, tick), radius_[index]);
+    }
+
+    void reserve(std::size_t size) {
+        x_.reserve(size);
+        y_.reserve(size);
+        speed_x_.reserve(size);
+        speed_y_.reserve(size);
+        radius_.reserve(size);
+    }
+
+    void add(const Point& position, const Point& speed, double radius) {
+        x_.push_back(position.x());
+        y_.push_back(position.y());
+        speed_x_.push_back(speed.x());
+        speed_y_.push_back(speed.y());
+        radius_.push_back(radius);
+    }
+
+    DynamicBarriers snapshot(double prev_tick, double tick) const;
+
+private:
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> speed_x_;
+    std::vector<double> speed_y_;
+    std::vector<double> radius_;
+};
+
+class PathBarriers {
+public:
+    PathBarriers();
+    PathBarriers(const Context& context);
+
+    const DynamicBarriersMotion& dynamic_barriers() const {
         return dynamic_barriers_;
     }
 
+    const CirclesGrid& static_barriers() const {
+        return static_barriers_;
+    }
+
 private:
-    DynamicBarriers dynamic_barriers_;
-    Occupier occupier_;
-    double max_distance_error_;
+    DynamicBarriersMotion dynamic_barriers_;
+    CirclesGrid static_barriers_;
+};
+
+struct PointsPairHash {
+    template <class T>
+    std::size_t operator ()(const std::pair<BasicPoint<T>, BasicPoint<T>>& value) const {
+        const auto first = std::hash<BasicPoint<T>>()(value.first);
+        const auto second = std::hash<BasicPoint<T>>()(value.second);
+        return first ^ (second + 0x9e3779b9 + (first << 6) + (first >> 2));
+    }
+};
+
+class PathSearchStorage {
+public:
+    using NodeIndex = std::uint32_t;
+
+    std::vector<StepState> steps;
+    std::vector<NodeIndex> queue;
+    std::vector<StepState> inconsistent;
+    FlatHashMap<PointInt, double> costs;
+    FlatHashSet<std::pair<PointInt, PointInt>, PointsPairHash> pushed;
+    FlatHashMap<Point, NodeIndex> came_from;
+    FlatHashSet<Point> visited;
+    std::vector<std::size_t> barriers;
+    MovingCircles candidates;
+    std::vector<char> intersections;
+    PathBarriers path_barriers;
+    int path_barriers_tick = -1;
+    Point path_barriers_position;
+    FlatHashMap<std::pair<Point, Point>, std::size_t, PointsPairHash> closest_static_barriers;
+
+    void clear() {
+        steps.clear();
+        queue.clear();
+        inconsistent.clear();
+        costs.clear();
+        pushed.clear();
+        came_from.clear();
+        visited.clear();
+        barriers.clear();
+        candidates.clear();
+        intersections.clear();
+        path_barriers = PathBarriers();
+        path_barriers_tick = -1;
+        closest_static_barriers.clear();
+    }
 };
 
 class GetOptimalPath {
@@ -89,6 +188,13 @@ public:
     GetOptimalPath& max_iterations(std::size_t value);
     GetOptimalPath& ticks_states(std::map<int, TickState>* value);
     GetOptimalPath& steps_states(std::vector<StepState>* value);
+    GetOptimalPath& storage(PathSearchStorage* value);
+    GetOptimalPath& tangent_graph(const TangentGraph* value);
+    GetOptimalPath& previous_path(const Path* value);
+    GetOptimalPath& anytime(bool value);
+    GetOptimalPath& anytime_time_budget(Duration value);
+    GetOptimalPath& corridor(const Corridor* value);
+    GetOptimalPath& flow_field(const FlowField* value);
 
 private:
     double step_size_ = 1;
@@ -96,8 +202,28 @@ private:
     std::size_t max_iterations_ = std::numeric_limits<std::size_t>::max();
     std::map<int, TickState>* ticks_states_ = nullptr;
     std::vector<StepState>* steps_states_ = nullptr;
+    PathSearchStorage* storage_ = nullptr;
+    const TangentGraph* tangent_graph_ = nullptr;
+    const Path* previous_path_ = nullptr;
+    bool anytime_ = false;
+    Duration anytime_time_budget_ = Duration::max();
+    const Corridor* corridor_ = nullptr;
+    const FlowField* flow_field_ = nullptr;
+};
+
+class IsPathValid {
+public:
+    bool operator ()(const Context& context, const Path& path) const;
+
+    IsPathValid& max_ticks(Tick value);
+    IsPathValid& storage(PathSearchStorage* value);
+
+private:
+    Tick max_ticks_ = std::numeric_limits<Tick>::max();
+    PathSearchStorage* storage_ = nullptr;
 };
 
+Path get_remaining_path(const Path& path, const Point& position);
 bool has_intersection_with_borders(const Circle& circle, double map_size);
 Circle make_circle(const model::CircularUnit* unit);
 std::pair<Point, Point> get_tangent_points(const Circle& circle, const Point& source);
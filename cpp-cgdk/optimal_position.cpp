@@ -44,50 +44,6 @@ double GetUnitIntersectionPenalty::get_safe_distance(const model::CircularUnit&
     return context.game().getStaffRange() + unit.getRadius();
 }
 
-double GetUnitDangerPenalty::operator ()(const model::Minion& unit, const Point& position, double sum_enemy_damage) const {
-    const auto my_bounds = make_unit_bounds(context.self(), context.game());
-    const auto time_to_position = get_position(context.self()).distance(position) / my_bounds.max_speed(0);
-    const auto& cached_unit = get_units<model::Minion>(context.cache()).at(unit.getId());
-    const auto unit_position = get_position(unit) + cached_unit.mean_speed() * time_to_position;
-    const auto distance_to_me = unit_position.distance(position);
-
-    if (distance_to_me < context.game().getStaffRange() + unit.getRadius() + context.self().getRadius()) {
-        return get_base(unit, position, sum_enemy_damage);
-    }
-
-    if (friend_units.empty()) {
-        return get_base(unit, position, sum_enemy_damage);
-    }
-    const auto nearest_friend = std::min_element(friend_units.begin(), friend_units.end(),
-        [&] (auto lhs, auto rhs) {
-            return unit_position.distance(get_position(*lhs)) < unit_position.distance(get_position(*rhs));
-        });
-    const auto distance_to_nearest = std::max({
-        unit_position.distance(get_position(**nearest_friend)),
-        unit.getRadius() + (*nearest_friend)->getRadius(),
-        unit.getRadius() + context.game().getStaffRange(),
-    });
-    if (distance_to_me - distance_to_nearest > context.self().getRadius()) {
-        return line_factor(distance_to_me, distance_to_nearest, 0);
-    }
-    return get_base(unit, position, sum_enemy_damage);
-}
-
-double GetUnitDangerPenalty::operator ()(const model::Building& unit, const Point& position, double sum_damage_to_me) const {
-    const auto base = get_base(unit, position, sum_damage_to_me);
-    if (unit.getType() == model::BUILDING_FACTION_BASE) {
-        const Point corner(context.world().getWidth(), 0);
-        const auto distance = position.distance(corner);
-        const auto from_prev_minions_spawn = context.world().getTickIndex() % MINIONS_SPAWN_PERIOD + 1;
-        const auto safe_distance = context.game().getFactionBaseAttackRange() * double(from_prev_minions_spawn) / double(MINIONS_SPAWN_PERIOD + 1)
-                + get_position(unit).distance(corner) + context.game().getFactionBaseRadius();
-        const auto spawned_minions_danger = line_factor(distance, safe_distance, 0);
-        return std::max(base, spawned_minions_danger);
-    } else {
-        return base;
-    }
-}
-
 Line GetProjectileTrajectory::operator ()(const CachedUnit<model::Projectile>& cached_unit) const {
     const auto& unit = cached_unit.value();
     switch (unit.getType()) {
@@ -5,6 +5,14 @@
 #include "circle.hpp"
 #include "optimal_target.hpp"
 #include "optimal_movement.hpp"
+#include "position_penalty_kernels.hpp"
+#include "position_warm_starts.hpp"
+
+#ifdef ELSID_STRATEGY_THREADS
+
+#include "thread_pool.hpp"
+
+#endif
 
 #include <stdexcept>
 #include <algorithm>
@@ -85,34 +93,6 @@ struct GetCurrentDamage {
     }
 };
 
-struct GetUnitDangerPenalty {
-    const Context& context;
-    const std::vector<const model::CircularUnit*>& friend_units;
-
-    template <class T>
-    double operator ()(const T& unit, const Point& position, double sum_damage_to_me) const {
-        return get_base(unit, position, sum_damage_to_me);
-    }
-
-    double operator ()(const model::Minion& unit, const Point& position, double sum_damage_to_me) const;
-    double operator ()(const model::Building& unit, const Point& position, double sum_damage_to_me) const;
-
-    template <class T>
-    double get_base(const T& unit, const Point& position, double sum_damage_to_me) const {
-        const GetAttackRange get_attack_range {context};
-        const GetMaxDamage get_max_damage {context};
-        const auto unit_position = get_position(unit);
-        const auto distance = position.distance(unit_position);
-        const auto permissible_damage = std::max(1.0, get_max_damage(unit, distance).sum());
-        const auto distance_factor = double(context.self().getMaxLife()) / permissible_damage
-                * sum_damage_to_me / context.self().getLife()
-                * double(context.self().getMaxLife()) / double(context.self().getLife());
-        const auto safe_distance = std::max(context.game().getStaffRange() + unit.getRadius() - 1,
-                2 * context.self().getRadius() + distance_factor * get_attack_range(unit, distance));
-        return line_factor(distance, safe_distance, 0);
-    }
-};
-
 struct GetProjectileTrajectory {
     const Context& context;
 
@@ -149,7 +129,8 @@ public:
     GetPositionPenalty(const Context& context, const Target* target, double max_distance)
             : context(context),
               target(target),
-              max_distance(max_distance) {
+              max_distance(max_distance),
+              my_bounds(make_unit_bounds(context.self(), context.game())) {
         const IsInMyRange is_in_my_range {context, max_distance};
 
         const auto initial_filter = [&] (const auto& units) {
@@ -205,98 +186,102 @@ public:
                 surround_units.push_back(make_surround_unit(&unit.second.value()));
             }
         }
+
+        fill_collision_barriers();
+        fill_bonuses_positions();
+        fill_projectiles_trajectories();
+        fill_elimination_targets();
+        fill_enemy_units();
+        fill_surround_pairs();
+        fill_target();
     }
 
     double operator ()(const Point& position) const {
-        context.check_timeout(__PRETTY_FUNCTION__, __FILE__, __LINE__);
-
-        const auto units_danger_penalty = get_units_danger_penalty(position) * UNITS_DANGER_PENALTY_WEIGHT;
-        const auto units_collision_penalty = get_units_collision_penalty(position) * UNITS_COLLISION_PENALTY_WEIGHT;
-        const auto bonuses_penalty = get_bonuses_penalty(position) * BONUSES_PENALTY_WEIGHT;
-        const auto projectiles_penalty = get_projectiles_penalty(position) * PROJECTILE_PENALTY_WEIGHT;
-        const auto friendly_fire_penalty = get_friendly_fire_penalty(position) * FRIENDLY_FIRE_PENALTY_WEIGHT;
-        const auto target_penalty = get_target_penalty(position) * TARGET_PENALTY_WEIGHT;
-        const auto borders_penalty = get_borders_penalty(position) * BORDERS_PENALTY_WEIGHT;
-        const auto friend_wizards_distance_penalty = get_friend_wizards_distance_penalty(position) * FRIEND_WIZARDS_DISTANCE_PENALTY_WEIGHT;
-        const auto surround_penalty = get_surround_penalty(position) * SURROUND_PENALTY_WEIGHT;
-
-        const auto max_penalty = std::max({
-            units_danger_penalty,
-            units_collision_penalty,
-            bonuses_penalty,
-            projectiles_penalty,
-            friendly_fire_penalty,
-            target_penalty,
-            borders_penalty,
-            friend_wizards_distance_penalty,
-            surround_penalty,
-        });
+        return apply(position, [&] (auto... args) { this->evaluate(args...); });
+    }
 
-        const auto elimination_score = get_elimination_score(position) * ELIMINATION_SCORE_WEIGHT;
+    void evaluate(const double* xs, const double* ys, double* result, std::size_t n) const {
+        std::array<double, POSITION_PENALTY_BATCH_SIZE> units_danger_penalties;
+        std::array<double, POSITION_PENALTY_BATCH_SIZE> units_collision_penalties;
+        std::array<double, POSITION_PENALTY_BATCH_SIZE> bonuses_penalties;
+        std::array<double, POSITION_PENALTY_BATCH_SIZE> projectiles_penalties;
+        std::array<double, POSITION_PENALTY_BATCH_SIZE> borders_penalties;
+        std::array<double, POSITION_PENALTY_BATCH_SIZE> surround_penalties;
+        std::array<double, POSITION_PENALTY_BATCH_SIZE> elimination_scores;
+
+        for (std::size_t begin = 0; begin < n; begin += POSITION_PENALTY_BATCH_SIZE) {
+            context.check_timeout(__PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+            const auto x = xs + begin;
+            const auto y = ys + begin;
+            const auto size = std::min(n - begin, POSITION_PENALTY_BATCH_SIZE);
+
+            get_units_danger_penalty(x, y, units_danger_penalties.data(), size);
+            get_units_collision_penalty(x, y, units_collision_penalties.data(), size);
+            get_bonuses_penalty(x, y, bonuses_penalties.data(), size);
+            get_projectiles_penalty(x, y, projectiles_penalties.data(), size);
+            get_borders_penalty(x, y, borders_penalties.data(), size);
+            get_surround_penalty(x, y, surround_penalties.data(), size);
+            get_elimination_score(x, y, elimination_scores.data(), size);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                const Point position(x[i], y[i]);
+
+                const auto units_danger_penalty = units_danger_penalties[i] * UNITS_DANGER_PENALTY_WEIGHT;
+                const auto units_collision_penalty = units_collision_penalties[i] * UNITS_COLLISION_PENALTY_WEIGHT;
+                const auto bonuses_penalty = bonuses_penalties[i] * BONUSES_PENALTY_WEIGHT;
+                const auto projectiles_penalty = projectiles_penalties[i] * PROJECTILE_PENALTY_WEIGHT;
+                const auto friendly_fire_penalty = get_friendly_fire_penalty(position) * FRIENDLY_FIRE_PENALTY_WEIGHT;
+                const auto target_penalty = get_target_penalty(position) * TARGET_PENALTY_WEIGHT;
+                const auto borders_penalty = borders_penalties[i] * BORDERS_PENALTY_WEIGHT;
+                const auto friend_wizards_distance_penalty = get_friend_wizards_distance_penalty(position) * FRIEND_WIZARDS_DISTANCE_PENALTY_WEIGHT;
+                const auto surround_penalty = surround_penalties[i] * SURROUND_PENALTY_WEIGHT;
+
+                const auto max_penalty = std::max({
+                    units_danger_penalty,
+                    units_collision_penalty,
+                    bonuses_penalty,
+                    projectiles_penalty,
+                    friendly_fire_penalty,
+                    target_penalty,
+                    borders_penalty,
+                    friend_wizards_distance_penalty,
+                    surround_penalty,
+                });
+
+                const auto elimination_score = elimination_scores[i] * ELIMINATION_SCORE_WEIGHT;
 
-        return max_penalty - elimination_score;
+                result[begin + i] = max_penalty - elimination_score;
+            }
+        }
     }
 
     double get_borders_penalty(const Point& position) const {
-        const auto left = get_borders_factor(position.x());
-        const auto right = get_borders_factor(context.game().getMapSize() - position.x());
-        const auto top = get_borders_factor(position.y());
-        const auto bottom = get_borders_factor(context.game().getMapSize() - position.y());
-        return std::max({left, right, top, bottom});
+        return apply(position, [&] (auto... args) { this->get_borders_penalty(args...); });
     }
 
     double get_projectiles_penalty(const Point& position) const {
-        const auto& projectiles = get_units<model::Projectile>(context.cache());
-        return std::accumulate(projectiles.begin(), projectiles.end(), - std::numeric_limits<double>::max(),
-            [&] (auto max, auto v) { return std::max(max, this->get_projectile_penalty(v.second, position)); });
+        return apply(position, [&] (auto... args) { this->get_projectiles_penalty(args...); });
     }
 
     double get_elimination_score(const Point& position) const {
-        const auto get_sum_elimination_score = [&] (const auto& units) {
-            return std::accumulate(units.begin(), units.end(), 0.0,
-                [&] (auto sum, const auto& v) { return sum + this->get_elimination_score(v.second, position); });
-        };
-
-        const auto buildings_score = get_sum_elimination_score(get_units<model::Building>(context.cache()));
-        const auto minions_score = get_sum_elimination_score(get_units<model::Minion>(context.cache()));
-        const auto wizards_score = get_sum_elimination_score(get_units<model::Wizard>(context.cache()));
-
-        return buildings_score + minions_score + wizards_score;
+        return apply(position, [&] (auto... args) { this->get_elimination_score(args...); });
     }
 
     double get_sum_damage_to_me(const Point& position) const {
-        const auto add_damage = [&] (auto sum, auto v) { return sum + this->get_unit_current_damage(*v, position); };
-
-        const double enemy_wizards_damage = std::accumulate(enemy_wizards.begin(), enemy_wizards.end(), 0.0, add_damage);
-        const double enemy_minions_damage = std::accumulate(enemy_minions.begin(), enemy_minions.end(), 0.0, add_damage);
-        const double enemy_buildings_damage = std::accumulate(enemy_buildings.begin(), enemy_buildings.end(), 0.0, add_damage);
-
-        return enemy_wizards_damage
-                + enemy_minions_damage
-                + enemy_buildings_damage
-                + is_with_status(context.self(), model::STATUS_BURNING)
-                    * double(context.game().getBurningSummaryDamage()) / double(context.game().getBurningDurationTicks());
+        return apply(position, [&] (auto... args) { this->get_sum_damage_to_me(args...); });
     }
 
     double get_units_danger_penalty(const Point& position) const {
-        const auto sum_damage_to_me = get_sum_damage_to_me(position);
-        const auto buildings_penalty = get_units_danger_penalty(enemy_buildings, position, sum_damage_to_me);
-        const auto minions_penalty = get_units_danger_penalty(enemy_minions, position, sum_damage_to_me);
-        const auto wizards_penalty = get_units_danger_penalty(enemy_wizards, position, sum_damage_to_me);
-        return std::max({buildings_penalty, minions_penalty, wizards_penalty});
+        return apply(position, [&] (auto... args) { this->get_units_danger_penalty(args...); });
     }
 
     double get_units_collision_penalty(const Point& position) const {
-        const auto buildings_penalty = get_units_collision_penalty(buildings, position);
-        const auto minions_penalty = get_units_collision_penalty(minions, position);
-        const auto trees_penalty = get_units_collision_penalty(trees, position);
-        const auto wizards_penalty = get_units_collision_penalty(wizards, position);
-        return std::max({buildings_penalty, minions_penalty, trees_penalty, wizards_penalty});
+        return apply(position, [&] (auto... args) { this->get_units_collision_penalty(args...); });
     }
 
     double get_bonuses_penalty(const Point& position) const {
-        return std::accumulate(bonuses.begin(), bonuses.end(), - std::numeric_limits<double>::max(),
-            [&] (auto max, auto v) { return std::max(max, this->get_bonus_penalty(*v, position)); });
+        return apply(position, [&] (auto... args) { this->get_bonuses_penalty(args...); });
     }
 
     double get_friendly_fire_penalty(const Point& position) const {
@@ -328,22 +313,7 @@ public:
     }
 
     double get_surround_penalty(const Point& position) const {
-        const auto borders_penalty = get_surround_penalty_by_borders(position);
-
-        if (surround_units.size() < 2) {
-            return borders_penalty;
-        }
-
-        const auto units_penalty = cross_product(surround_units.begin(), surround_units.end() - 1,
-            surround_units.begin() + 1, surround_units.end(),
-            - std::numeric_limits<double>::max(), [] (auto lhs, auto rhs) { return std::max(lhs, rhs); },
-            [&] (const auto& lhs, const auto& rhs) { return this->get_surround_penalty(lhs, rhs, position); });
-
-        const auto units_and_borders_penalty = std::accumulate(surround_units.begin(), surround_units.end(),
-            - std::numeric_limits<double>::max(),
-            [&] (auto max, const auto& unit) { return std::max(max, this->get_surround_penalty_by_borders(unit, position)); });
-
-        return std::max({borders_penalty, units_penalty, units_and_borders_penalty});
+        return apply(position, [&] (auto... args) { this->get_surround_penalty(args...); });
     }
 
 private:
@@ -352,6 +322,12 @@ private:
         double influence_radius;
     };
 
+    struct TargetAttack {
+        double max_distance;
+        double ticks_factor;
+        double unit_life_factor;
+    };
+
     const Context& context;
     const Target* const target;
     const double max_distance;
@@ -368,41 +344,331 @@ private:
     std::vector<const model::Building*> friend_buildings;
     std::vector<const model::Minion*> friend_minions;
     std::vector<SurroundUnit> surround_units;
+    const WizardBounds my_bounds;
+    CollisionBarriers collision_barriers;
+    BonusesPositions bonuses_positions;
+    ProjectilesTrajectories projectiles_trajectories;
+    std::array<EliminationTargets, 3> elimination_targets;
+    SurroundPairs surround_pairs;
+    UnitsDanger units_danger;
+    UnitsDanger::Parameters units_danger_parameters;
+    Point target_position;
+    Point target_future_position;
+    double target_range = 0;
+    double target_my_life_factor = 0;
+    std::vector<TargetAttack> target_attacks;
 
-    double get_bonus_penalty(const model::Bonus& unit, const Point& position) const {
-        const auto distance = position.distance(get_position(unit));
-        const auto has_nearest_friend = friend_wizards.end() != std::find_if(friend_wizards.begin(), friend_wizards.end(),
-                     [&] (auto v) { return get_position(*v).distance(get_position(unit)) < distance; });
+    template <class Function>
+    static double apply(const Point& position, const Function& function) {
+        const auto x = position.x();
+        const auto y = position.y();
+        double result;
+        function(&x, &y, &result, std::size_t(1));
+        return result;
+    }
 
-        if (has_nearest_friend) {
-            return - std::numeric_limits<double>::max();
+    void get_sum_damage_to_me(const double* xs, const double* ys, double* result, std::size_t n) const {
+        units_danger.get_sum_damage(xs, ys, units_danger_parameters, result, n);
+    }
+
+    void get_units_danger_penalty(const double* xs, const double* ys, double* result, std::size_t n) const {
+        units_danger.get_penalty(xs, ys, units_danger_parameters, result, n);
+    }
+
+    void get_units_collision_penalty(const double* xs, const double* ys, double* result, std::size_t n) const {
+        collision_barriers.get_penalty(xs, ys, result, n);
+    }
+
+    void get_bonuses_penalty(const double* xs, const double* ys, double* result, std::size_t n) const {
+        bonuses_positions.get_penalty(xs, ys, max_distance, result, n);
+    }
+
+    void get_projectiles_penalty(const double* xs, const double* ys, double* result, std::size_t n) const {
+        projectiles_trajectories.get_penalty(xs, ys, result, n);
+    }
+
+    void get_borders_penalty(const double* xs, const double* ys, double* result, std::size_t n) const {
+        strategy::get_borders_penalty(xs, ys, context.game().getMapSize(), context.self().getRadius(), result, n);
+    }
+
+    void get_surround_penalty(const double* xs, const double* ys, double* result, std::size_t n) const {
+        for (std::size_t i = 0; i < n; ++i) {
+            result[i] = get_surround_penalty_by_borders(Point(xs[i], ys[i]));
         }
 
-        return line_factor(distance, 0, max_distance);
+        if (surround_units.size() < 2) {
+            return;
+        }
+
+        std::array<double, POSITION_PENALTY_BATCH_SIZE> units_penalties;
+        surround_pairs.get_penalty(xs, ys, units_penalties.data(), n);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            result[i] = std::max(result[i], units_penalties[i]);
+        }
     }
 
-    double get_projectile_penalty(const CachedUnit<model::Projectile>& cached_unit, const Point& position) const {
-        const auto& unit = cached_unit.value();
+    void get_elimination_score(const double* xs, const double* ys, double* result, std::size_t n) const {
+        std::array<std::array<double, POSITION_PENALTY_BATCH_SIZE>, 3> scores;
 
-        if (unit.getFaction() == context.self().getFaction()) {
-            return - std::numeric_limits<double>::max();
+        for (std::size_t i = 0; i < elimination_targets.size(); ++i) {
+            elimination_targets[i].get_score(xs, ys, context.game().getScoreGainRange(), context.self().getRadius(),
+                                             scores[i].data(), n);
         }
 
-        const auto trajectory = get_projectile_trajectory(cached_unit);
-        const auto lethal_area = get_projectile_lethal_area(unit.getType());
-        const auto nearest = trajectory.nearest(position);
-        const auto has_point = trajectory.has_point(nearest);
-        const auto distance = has_point ? nearest.distance(position)
-                                        : std::min(trajectory.begin().distance(position), trajectory.end().distance(position));
-        const auto safe_distance = lethal_area + context.self().getRadius() + 1;
+        for (std::size_t i = 0; i < n; ++i) {
+            result[i] = scores[0][i] + scores[1][i] + scores[2][i];
+        }
+    }
 
-        if (distance < safe_distance) {
-            return 1 + 0.1 * line_factor(distance, safe_distance, 0);
-        } else {
-            return line_factor(distance, 2 * safe_distance, safe_distance);
+    void fill_collision_barriers() {
+        const auto add = [&] (const auto& units) {
+            for (const auto unit : units) {
+                collision_barriers.add(get_position(*unit), context.game().getStaffRange() + unit->getRadius(),
+                                       this->is_increased_collision_penalty(*unit));
+            }
+        };
+
+        add(buildings);
+        add(minions);
+        add(trees);
+        add(wizards);
+    }
+
+    bool is_increased_collision_penalty(const model::CircularUnit&) const {
+        return false;
+    }
+
+    bool is_increased_collision_penalty(const model::Minion& unit) const {
+        return unit.getFaction() == model::FACTION_NEUTRAL;
+    }
+
+    bool is_increased_collision_penalty(const model::Tree&) const {
+        return true;
+    }
+
+    void fill_bonuses_positions() {
+        for (const auto unit : bonuses) {
+            auto nearest_friend_distance = std::numeric_limits<double>::max();
+            for (const auto v : friend_wizards) {
+                nearest_friend_distance = std::min(nearest_friend_distance, get_position(*v).distance(get_position(*unit)));
+            }
+            bonuses_positions.add(get_position(*unit), nearest_friend_distance);
+        }
+    }
+
+    void fill_projectiles_trajectories() {
+        for (const auto& v : get_units<model::Projectile>(context.cache())) {
+            if (v.second.value().getFaction() != context.self().getFaction()) {
+                const auto lethal_area = get_projectile_lethal_area(v.second.value().getType());
+                projectiles_trajectories.add(get_projectile_trajectory(v.second),
+                                             lethal_area + context.self().getRadius() + 1);
+            }
+        }
+    }
+
+    void fill_elimination_targets() {
+        const auto add = [&] (const auto& units, EliminationTargets& targets) {
+            for (const auto& v : units) {
+                const auto factor = this->get_elimination_factor(v.second);
+                if (factor != 0) {
+                    targets.add(get_position(v.second.value()), factor);
+                }
+            }
+        };
+
+        add(get_units<model::Building>(context.cache()), elimination_targets[0]);
+        add(get_units<model::Minion>(context.cache()), elimination_targets[1]);
+        add(get_units<model::Wizard>(context.cache()), elimination_targets[2]);
+    }
+
+    void fill_surround_pairs() {
+        if (surround_units.size() < 2) {
+            return;
+        }
+
+        for (auto unit = std::next(surround_units.begin()); unit != surround_units.end(); ++unit) {
+            add_surround_pair(surround_units.front(), *unit);
+        }
+
+        const auto my_position = get_position(context.self());
+
+        for (const auto& unit : surround_units) {
+            const Point left(0, unit.position.y());
+            const Point right(context.world().getWidth(), unit.position.y());
+            const Point top(unit.position.x(), 0);
+            const Point bottom(unit.position.x(), context.world().getHeight());
+
+            for (const auto& border : {left, right, top, bottom}) {
+                if (border.distance(my_position) <= max_distance) {
+                    add_surround_pair(SurroundUnit {border, context.game().getWizardCastRange() * 0.5}, unit);
+                }
+            }
+        }
+    }
+
+    void add_surround_pair(const SurroundUnit& lhs, const SurroundUnit& rhs) {
+        const auto diameter = lhs.position - rhs.position;
+        const auto units_distance = diameter.norm();
+        const auto max_distance = lhs.influence_radius + rhs.influence_radius;
+
+        if (units_distance < max_distance) {
+            surround_pairs.add(rhs.position + 0.5 * diameter, units_distance, max_distance);
         }
     }
 
+    void fill_enemy_units() {
+        const ReduceDamage reduce_damage {context};
+        const auto hastened_remaining_ticks = get_hastened_remaining_ticks(context.self());
+
+        units_danger_parameters.my_position = get_position(context.self());
+        units_danger_parameters.my_radius = context.self().getRadius();
+        units_danger_parameters.my_life = context.self().getLife();
+        units_danger_parameters.my_max_life = context.self().getMaxLife();
+        units_danger_parameters.my_max_speed = my_bounds.max_speed(0);
+        units_danger_parameters.my_strafe_speed = my_bounds.max_strafe_speed(hastened_remaining_ticks);
+        units_danger_parameters.my_hastened_strafe_speed = my_bounds.max_strafe_speed(0);
+        units_danger_parameters.my_hastened_remaining_ticks = hastened_remaining_ticks;
+        units_danger_parameters.burning_damage = is_with_status(context.self(), model::STATUS_BURNING)
+                * double(context.game().getBurningSummaryDamage()) / double(context.game().getBurningDurationTicks());
+        units_danger_parameters.magic_damage_factor = 1 - reduce_damage.get_status_factor(context.self());
+        units_danger_parameters.magic_damage_reduction = reduce_damage.get_skills_reduction(context.self());
+        units_danger_parameters.reduce_damage_by_friends = context.self().getLife() > 3.0 * context.self().getMaxLife() / 4;
+        units_danger_parameters.staff_range = context.game().getStaffRange();
+        units_danger_parameters.max_turn_angle = context.game().getWizardMaxTurnAngle();
+        units_danger_parameters.max_cast_angle = context.game().getStaffSector() / 2;
+        units_danger_parameters.minions_spawn_corner = Point(context.world().getWidth(), 0);
+
+        for (const auto unit : friend_units) {
+            units_danger.add_friend(get_position(*unit), unit->getRadius());
+        }
+
+        const auto add = [&] (const auto& units) {
+            for (const auto unit : units) {
+                this->add_enemy_unit(*unit);
+            }
+            units_danger.finish_group();
+        };
+
+        add(enemy_wizards);
+        add(enemy_minions);
+        add(enemy_buildings);
+    }
+
+    template <class Unit>
+    void add_enemy_unit(const Unit& unit) {
+        const GetAttackRange get_attack_range {context};
+        const GetMaxDamage get_max_damage {context};
+        const GetUnitAttackAbility get_attack_ability {context};
+        const auto unit_position = get_position(unit);
+
+        UnitsDanger::Unit enemy;
+        enemy.position = unit_position;
+        enemy.radius = unit.getRadius();
+        enemy.min_safe_distance = context.game().getStaffRange() + unit.getRadius() - 1;
+        enemy.attack_ability = get_attack_ability(unit);
+        enemy.is_rotating = std::is_same<Unit, model::Wizard>::value;
+        enemy.is_minion = std::is_same<Unit, model::Minion>::value;
+        enemy.mean_speed = get_enemy_mean_speed(unit);
+        enemy.is_faction_base = is_faction_base(unit);
+        enemy.spawned_minions_safe_distance = enemy.is_faction_base ? get_spawned_minions_safe_distance(unit) : 0;
+        enemy.angle = unit.getAngle();
+        enemy.max_turn = make_unit_bounds(unit, context.game()).max_turn(0);
+
+        for (const auto distance : get_attack_distances(unit)) {
+            const auto attack_range = get_attack_range(unit, distance);
+            const auto max_damage = get_max_damage(unit, distance);
+            units_danger.add_attack(UnitsDanger::Attack {
+                distance,
+                attack_range + context.self().getRadius(),
+                max_damage,
+                attack_range,
+                std::max(1.0, max_damage.sum()),
+            });
+        }
+
+        for (const auto v : friend_minions) {
+            units_danger.add_friend_minion_distance(get_position(*v).distance(unit_position));
+        }
+
+        for (const auto v : friend_wizards) {
+            units_danger.add_friend_wizard_distance(get_position(*v).distance(unit_position));
+        }
+
+        units_danger.add(enemy);
+    }
+
+    template <class Unit>
+    Point get_enemy_mean_speed(const Unit&) const {
+        return Point(0, 0);
+    }
+
+    Point get_enemy_mean_speed(const model::Minion& unit) const {
+        return get_units<model::Minion>(context.cache()).at(unit.getId()).mean_speed();
+    }
+
+    template <class Unit>
+    bool is_faction_base(const Unit&) const {
+        return false;
+    }
+
+    bool is_faction_base(const model::Building& unit) const {
+        return unit.getType() == model::BUILDING_FACTION_BASE;
+    }
+
+    double get_spawned_minions_safe_distance(const model::CircularUnit& unit) const {
+        const Point corner(context.world().getWidth(), 0);
+        const auto from_prev_minions_spawn = context.world().getTickIndex() % MINIONS_SPAWN_PERIOD + 1;
+        return context.game().getFactionBaseAttackRange() * double(from_prev_minions_spawn) / double(MINIONS_SPAWN_PERIOD + 1)
+                + get_position(unit).distance(corner) + context.game().getFactionBaseRadius();
+    }
+
+    void fill_target() {
+        if (target) {
+            fill_target(*target);
+        }
+    }
+
+    template <class Unit>
+    void fill_target(const Unit& unit) {
+        const GetMaxDamage get_max_damage {context};
+        target_position = get_position(unit);
+        target_future_position = target_position + get_speed(unit);
+        target_range = get_target_range(unit);
+        target_my_life_factor = double(context.self().getLife()) / double(context.self().getMaxLife());
+
+        for (const auto distance : get_attack_distances(context.self())) {
+            const auto ticks_to_action = get_max_damage.next_attack_action(context.self(), distance).second;
+            target_attacks.push_back(TargetAttack {
+                distance,
+                bounded_line_factor(ticks_to_action, context.game().getWizardActionCooldownTicks(), 0),
+                1 + bounded_line_factor(unit.getLife(), 2 * get_max_damage(context.self(), distance).sum(), 0),
+            });
+        }
+    }
+
+    void fill_target(const model::Bonus&) {}
+
+    void fill_target(const model::LivingUnit&) {}
+
+    template <class Unit>
+    std::vector<double> get_attack_distances(const Unit&) const {
+        return {std::numeric_limits<double>::max()};
+    }
+
+    std::vector<double> get_attack_distances(const model::Wizard& unit) const {
+        const GetAttackRange get_attack_range {context};
+        std::vector<double> result;
+        result.reserve(GetMaxDamage::ATTACK_ACTIONS.size() + 1);
+        for (const auto action : GetMaxDamage::ATTACK_ACTIONS) {
+            result.push_back(get_attack_range(unit, action));
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        result.push_back(std::numeric_limits<double>::max());
+        return result;
+    }
+
     Line get_projectile_trajectory(const CachedUnit<model::Projectile>& cached_unit) const {
         const GetProjectileTrajectory impl {context};
         return impl(cached_unit);
@@ -458,68 +724,23 @@ private:
     }
 
     template <class Unit>
-    double get_elimination_score(const CachedUnit<Unit>& unit, const Point& position) const {
-        return get_base_elimination_score(unit, position);
+    double get_elimination_factor(const CachedUnit<Unit>& unit) const {
+        return get_base_elimination_factor(unit);
     }
 
-    double get_elimination_score(const CachedUnit<model::Building>& unit, const Point& position) const {
-        return unit.value().getType() == model::BUILDING_FACTION_BASE ? 0 : get_base_elimination_score(unit, position);
+    double get_elimination_factor(const CachedUnit<model::Building>& unit) const {
+        return unit.value().getType() == model::BUILDING_FACTION_BASE ? 0 : get_base_elimination_factor(unit);
     }
 
     template <class Unit>
-    double get_base_elimination_score(const CachedUnit<Unit>& unit, const Point& position) const {
+    double get_base_elimination_factor(const CachedUnit<Unit>& unit) const {
         const auto mean_life_change_speed = unit.mean_life_change_speed();
 
         if (!is_enemy(unit.value(), context.self().getFaction()) || mean_life_change_speed >= 0) {
             return 0;
         }
 
-        const auto distance = get_position(unit.value()).distance(position);
-        const auto factor = bounded_line_factor(-mean_life_change_speed * 30, 0, unit.value().getLife());
-
-        if (distance <= context.game().getScoreGainRange() - context.self().getRadius()) {
-            return factor * (1 + 0.1 * bounded_line_factor(distance, context.game().getScoreGainRange()- context.self().getRadius(), 0));
-        } else {
-            return factor * bounded_line_factor(distance, context.game().getScoreGainRange(), context.game().getScoreGainRange() - context.self().getRadius());
-        }
-    }
-
-    double get_borders_factor(double distance) const {
-        return line_factor(distance, 2 * context.self().getRadius() + 1, context.self().getRadius() + 1);
-    }
-
-    template <class Unit>
-    double get_unit_current_damage(const Unit& unit, const Point& position) const {
-        const GetCurrentDamage get_current_damage {context};
-        const ReduceDamage reduce_damage {context};
-        const auto current_damage = get_current_damage(unit, position);
-        const auto reduced_damage = reduce_damage(context.self(), current_damage);
-
-        if (context.self().getLife() <= 3.0 * context.self().getMaxLife() / 4) {
-            return reduced_damage.sum();
-        }
-
-        const auto unit_position = get_position(unit);
-        const auto distance = position.distance(unit_position);
-        const auto is_nearest = [&] (auto v) { return get_position(*v).distance(unit_position) < distance; };
-        const auto nearest_minions_count = std::count_if(friend_minions.begin(), friend_minions.end(), is_nearest);
-        const auto nearest_wizards_count = std::count_if(friend_wizards.begin(), friend_wizards.end(), is_nearest);
-
-        return reduced_damage.sum() / (1 + nearest_minions_count + std::sqrt(nearest_wizards_count));
-    }
-
-    template <class Unit>
-    double get_units_danger_penalty(const std::vector<const Unit*>& units, const Point& position, double sum_damage_to_me) const {
-        const GetUnitDangerPenalty get_unit_danger_penalty {context, friend_units};
-        return std::accumulate(units.begin(), units.end(), - std::numeric_limits<double>::max(),
-            [&] (auto max, auto v) { return std::max(max, get_unit_danger_penalty(*v, position, sum_damage_to_me)); });
-    }
-
-    template <class Unit>
-    double get_units_collision_penalty(const std::vector<const Unit*>& units, const Point& position) const {
-        const GetUnitIntersectionPenalty get_unit_collision_penalty {context};
-        return std::accumulate(units.begin(), units.end(), - std::numeric_limits<double>::max(),
-           [&] (auto max, auto v) { return std::max(max, get_unit_collision_penalty(*v, position)); });
+        return bounded_line_factor(-mean_life_change_speed * 30, 0, unit.value().getLife());
     }
 
     template <class Unit>
@@ -529,23 +750,31 @@ private:
     }
 
     template <class Unit>
-    double get_target_penalty(const Unit& unit, const Point& position) const {
-        const GetMaxDamage get_max_damage {context};
-        const auto current_distance = position.distance(get_position(unit));
-        const auto future_distance = position.distance(get_position(unit) + get_speed(unit));
+    double get_target_penalty(const Unit&, const Point& position) const {
+        const auto current_distance = position.distance(target_position);
+        const auto future_distance = position.distance(target_future_position);
         const auto distance = std::max(current_distance, future_distance);
-        const auto range = get_target_range(unit);
 
-        if (distance <= range) {
-            return line_factor(distance, range, 0);
+        if (distance <= target_range) {
+            return line_factor(distance, target_range, 0);
         }
 
-        const auto ticks_to_action = get_max_damage.next_attack_action(context.self(), distance).second;
-        const auto ticks_factor = bounded_line_factor(ticks_to_action, context.game().getWizardActionCooldownTicks(), 0);
-        const auto my_life_factor = double(context.self().getLife()) / double(context.self().getMaxLife());
-        const auto distance_factor = line_factor(distance, 0, range) - 1;
-        const auto unit_life_factor = 1 + bounded_line_factor(unit.getLife(), 2 * get_max_damage(context.self(), distance).sum(), 0);
-        return distance_factor * ticks_factor * my_life_factor * unit_life_factor;
+        const auto attack = std::find_if(target_attacks.begin(), target_attacks.end(),
+            [&] (const auto& v) { return distance <= v.max_distance; });
+        const auto distance_factor = line_factor(distance, 0, target_range) - 1;
+        return distance_factor * attack->ticks_factor * target_my_life_factor * attack->unit_life_factor;
+    }
+
+    double get_bonus_penalty(const model::Bonus& unit, const Point& position) const {
+        const auto distance = position.distance(get_position(unit));
+        const auto has_nearest_friend = friend_wizards.end() != std::find_if(friend_wizards.begin(), friend_wizards.end(),
+                     [&] (auto v) { return get_position(*v).distance(get_position(unit)) < distance; });
+
+        if (has_nearest_friend) {
+            return - std::numeric_limits<double>::max();
+        }
+
+        return line_factor(distance, 0, max_distance);
     }
 
     double get_target_penalty(const model::Bonus& unit, const Point& position) const {
@@ -575,25 +804,6 @@ private:
         }
     }
 
-    double get_surround_penalty_by_borders(const SurroundUnit& unit, const Point& position) const {
-        const Point left(0, unit.position.y());
-        const Point right(context.world().getWidth(), unit.position.y());
-        const Point top(unit.position.x(), 0);
-        const Point bottom(unit.position.x(), context.world().getHeight());
-
-        const auto borders = {left, right, top, bottom};
-        const auto my_position = get_position(context.self());
-
-        return std::accumulate(borders.begin(), borders.end(), - std::numeric_limits<double>::max(),
-            [&] (auto max, const auto& border) {
-                if (border.distance(my_position) <= max_distance) {
-                    return std::max(max, this->get_surround_penalty(SurroundUnit {border, context.game().getWizardCastRange() * 0.5}, unit, position));
-                } else {
-                    return max;
-                }
-            });
-    }
-
     double get_surround_penalty_by_borders(const Point& position) const {
         const std::array<SurroundUnit, 4> borders = {{
                SurroundUnit {Point(0, position.y()), context.game().getWizardCastRange() / 3},
@@ -632,6 +842,13 @@ private:
     }
 };
 
+struct OptimalPositionStats {
+    long raster_function_calls = 0;
+    Duration raster_duration = Duration::zero();
+    long refine_function_calls = 0;
+    Duration refine_duration = Duration::zero();
+};
+
 template <class TargetUnitT>
 class GetOptimalPosition {
 public:
@@ -639,16 +856,34 @@ public:
 
     Point operator ()(const Context& context) const {
         const GetPositionPenalty<TargetUnit> get_position_penalty(context, target_, max_distance_);
-        if (points_) {
-            return minimize(context,
-                [&] (const Point& point) {
-                    const auto result = get_position_penalty(point);
-                    points_->emplace_back(point, result);
-                    return result;
-                });
-        } else {
-            return minimize(context, get_position_penalty);
+        const auto my_position = get_position(context.self());
+        const auto target_position = target_ ? get_position(*target_) : my_position;
+        const auto tick = context.world().getTickIndex();
+
+        const auto warm_start_units = warm_starts_ ? get_warm_start_units(context) : std::vector<UnitId>();
+        const auto warm_start = warm_starts_
+                ? warm_starts_->get(warm_start_key_, tick, my_position, target_position, warm_start_units)
+                : std::make_pair(false, PositionWarmStart());
+
+        const auto result = [&] {
+            if (starts_ > 1) {
+                return this->minimize_from_starts(context, get_position_penalty, warm_start);
+            } else if (warm_start.first) {
+                return this->minimize(context, warm_start.second.position,
+                                      std::max(precision_, warm_start.second.trust_region_radius),
+                                      max_function_calls_, get_position_penalty).second;
+            } else if (raster_size_ > 0 && refined_cells_ > 0) {
+                return this->minimize_from_raster(context, get_position_penalty);
+            } else {
+                return this->minimize(context, my_position, precision_, max_function_calls_, get_position_penalty).second;
+            }
+        } ();
+
+        if (warm_starts_) {
+            warm_starts_->update(warm_start_key_, tick, my_position, target_position, warm_start_units, result);
         }
+
+        return result;
     }
 
     GetOptimalPosition& target(const TargetUnit* value) {
@@ -676,21 +911,370 @@ public:
         return *this;
     }
 
+    GetOptimalPosition& raster_size(std::size_t value) {
+        raster_size_ = value;
+        return *this;
+    }
+
+    GetOptimalPosition& refined_cells(std::size_t value) {
+        refined_cells_ = value;
+        return *this;
+    }
+
+    GetOptimalPosition& stats(OptimalPositionStats* value) {
+        stats_ = value;
+        return *this;
+    }
+
+    GetOptimalPosition& starts(std::size_t value) {
+        starts_ = value;
+        return *this;
+    }
+
+#ifdef ELSID_STRATEGY_THREADS
+    GetOptimalPosition& thread_pool(ThreadPool* value) {
+        thread_pool_ = value;
+        return *this;
+    }
+#endif
+
+    GetOptimalPosition& warm_starts(PositionWarmStarts* value, const PositionKey& key) {
+        warm_starts_ = value;
+        warm_start_key_ = key;
+        return *this;
+    }
+
+    long get_max_function_calls_per_start(std::size_t starts_count, long raster_function_calls = 0) const {
+        const auto threads = long(std::min(get_threads_count(), starts_count));
+        return (max_function_calls_ - raster_function_calls) / long(starts_count) * threads;
+    }
+
 private:
     const TargetUnit* target_ = nullptr;
     double max_distance_ = std::numeric_limits<double>::max();
     double precision_ = 1e-3;
     long max_function_calls_ = std::numeric_limits<long>::max();
+    std::size_t raster_size_ = 0;
+    std::size_t refined_cells_ = 0;
     std::vector<std::pair<Point, double>>* points_ = nullptr;
+    OptimalPositionStats* stats_ = nullptr;
+    std::size_t starts_ = 0;
+#ifdef ELSID_STRATEGY_THREADS
+    ThreadPool* thread_pool_ = nullptr;
+#endif
+    PositionWarmStarts* warm_starts_ = nullptr;
+    PositionKey warm_start_key_ = PositionKey {PositionCase::NO_TARGET, 0};
+
+    struct Raster {
+        std::vector<double> xs;
+        std::vector<double> ys;
+        std::vector<double> values;
+        std::vector<std::size_t> order;
+        std::size_t seeds_count;
+        Point cell_size;
+
+        Point position(std::size_t index) const {
+            return Point(xs[index], ys[index]);
+        }
+    };
+
+    Point get_lower_bound(const Context& context) const {
+        return Point(context.self().getRadius() + 1, context.self().getRadius() + 1);
+    }
+
+    Point get_upper_bound(const Context& context) const {
+        return Point(context.world().getWidth() - context.self().getRadius() - 1, context.world().getHeight() - context.self().getRadius() - 1);
+    }
+
+    Raster get_raster(const Context& context, const GetPositionPenalty<TargetUnit>& get_position_penalty,
+                      std::size_t seeds_count) const {
+        const auto start = Clock::now();
+        const auto my_position = get_position(context.self());
+        const auto lower_bound = get_lower_bound(context);
+        const auto upper_bound = get_upper_bound(context);
+        const auto radius = std::min(max_distance_, std::max(context.world().getWidth(), context.world().getHeight()));
+        const Point min(std::max(lower_bound.x(), my_position.x() - radius), std::max(lower_bound.y(), my_position.y() - radius));
+        const Point max(std::min(upper_bound.x(), my_position.x() + radius), std::min(upper_bound.y(), my_position.y() + radius));
+
+        Raster result;
+        result.cell_size = (max - min) / double(raster_size_);
+        result.xs.reserve(raster_size_ * raster_size_ + 1);
+        result.ys.reserve(raster_size_ * raster_size_ + 1);
+        result.xs.push_back(my_position.x());
+        result.ys.push_back(my_position.y());
+
+        for (std::size_t x = 0; x < raster_size_; ++x) {
+            for (std::size_t y = 0; y < raster_size_; ++y) {
+                result.xs.push_back(min.x() + (x + 0.5) * result.cell_size.x());
+                result.ys.push_back(min.y() + (y + 0.5) * result.cell_size.y());
+            }
+        }
+
+        result.values.resize(result.xs.size());
+        get_position_penalty.evaluate(result.xs.data(), result.ys.data(), result.values.data(), result.values.size());
+
+        if (points_) {
+            for (std::size_t i = 0; i < result.values.size(); ++i) {
+                points_->emplace_back(result.position(i), result.values[i]);
+            }
+        }
+
+        result.order.resize(result.values.size());
+        std::iota(result.order.begin(), result.order.end(), 0);
+        result.seeds_count = std::min(seeds_count, result.order.size());
+        std::partial_sort(result.order.begin(), result.order.begin() + result.seeds_count, result.order.end(),
+            [&] (auto lhs, auto rhs) { return result.values[lhs] < result.values[rhs]; });
+
+        if (stats_) {
+            stats_->raster_function_calls += long(result.values.size());
+            stats_->raster_duration += Clock::now() - start;
+        }
+
+        return result;
+    }
+
+    double get_raster_trust_region_radius(const Raster& raster) const {
+        return std::max(precision_, 0.5 * std::min(raster.cell_size.x(), raster.cell_size.y()));
+    }
+
+    Point minimize_from_raster(const Context& context, const GetPositionPenalty<TargetUnit>& get_position_penalty) const {
+        const auto raster = get_raster(context, get_position_penalty, refined_cells_);
+        const auto seeds_end = raster.order.begin() + raster.seeds_count;
+        const auto raster_function_calls = long(raster.values.size());
+
+        auto result = std::make_pair(raster.values[raster.order.front()], raster.position(raster.order.front()));
+        const auto refine_function_calls = (max_function_calls_ - raster_function_calls) / long(raster.seeds_count);
+
+        if (refine_function_calls <= 0) {
+            return result.second;
+        }
+
+        const auto initial_trust_region_radius = get_raster_trust_region_radius(raster);
+
+        std::for_each(raster.order.begin(), seeds_end, [&] (auto index) {
+            const auto refined = this->minimize(context, raster.position(index), initial_trust_region_radius,
+                                                refine_function_calls, get_position_penalty);
+            if (refined.first < result.first) {
+                result = refined;
+            }
+        });
+
+        return result.second;
+    }
+
+    std::vector<UnitId> get_warm_start_units(const Context& context) const {
+        const IsInMyRange is_in_my_range {context, max_distance_};
+        std::vector<UnitId> result;
+        const auto add = [&] (const auto& units) {
+            for (const auto& unit : units) {
+                const auto& value = unit.second.value();
+                if (value.getFaction() != context.self().getFaction() && is_in_my_range(value)) {
+                    result.push_back(value.getId());
+                }
+            }
+        };
+        add(get_units<model::Wizard>(context.cache()));
+        add(get_units<model::Minion>(context.cache()));
+        add(get_units<model::Building>(context.cache()));
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    std::vector<Point> get_starts(const Context& context, const std::pair<bool, PositionWarmStart>& warm_start) const {
+        const auto my_position = get_position(context.self());
+        const auto lower_bound = get_lower_bound(context);
+        const auto upper_bound = get_upper_bound(context);
+        const auto bounded = [&] (const Point& position) {
+            return Point(std::min(upper_bound.x(), std::max(lower_bound.x(), position.x())),
+                         std::min(upper_bound.y(), std::max(lower_bound.y(), position.y())));
+        };
+
+        std::vector<Point> result;
+        result.reserve(starts_);
+        result.push_back(my_position);
+
+        if (warm_start.first) {
+            result.push_back(warm_start.second.position);
+        }
+
+        const auto cast_range = context.self().getCastRange();
+        const auto target_position = target_ ? get_position(*target_) : my_position;
+        const auto from_target = my_position - target_position;
+
+        if (target_ && from_target.norm() > 0) {
+            result.push_back(bounded(my_position + from_target.normalized() * cast_range));
+        }
+
+        const auto ring_size = starts_ > result.size() ? starts_ - result.size() : 0;
+        const auto ring_radius = target_ ? cast_range : 0.5 * cast_range;
+        const auto ring_direction = from_target.norm() > 0 ? from_target.normalized() : Point(1, 0);
+
+        for (std::size_t i = 0; i < ring_size; ++i) {
+            const auto angle = 2 * M_PI * double(i) / double(ring_size);
+            result.push_back(bounded(target_position + ring_direction.rotated(angle) * ring_radius));
+        }
+
+        result.resize(std::min(result.size(), starts_));
+
+        return result;
+    }
+
+    Point minimize_from_starts(const Context& context, const GetPositionPenalty<TargetUnit>& get_position_penalty,
+                               const std::pair<bool, PositionWarmStart>& warm_start) const {
+        std::vector<Point> starts;
+        std::vector<double> initial_trust_region_radii;
+        std::pair<double, Point> raster_best(std::numeric_limits<double>::max(), get_position(context.self()));
+        long raster_function_calls = 0;
+
+        if (!warm_start.first && raster_size_ > 0 && refined_cells_ > 0) {
+            const auto raster = get_raster(context, get_position_penalty, starts_);
+            const auto initial_trust_region_radius = get_raster_trust_region_radius(raster);
+            raster_best = std::make_pair(raster.values[raster.order.front()], raster.position(raster.order.front()));
+            raster_function_calls = long(raster.values.size());
+            const auto seeds_end = raster.order.begin() + raster.seeds_count;
+            for (auto index = raster.order.begin(); index != seeds_end && starts.size() < starts_; ++index) {
+                starts.push_back(raster.position(*index));
+            }
+            initial_trust_region_radii.resize(starts.size(), initial_trust_region_radius);
+        } else {
+            starts = get_starts(context, warm_start);
+            initial_trust_region_radii.resize(starts.size(), std::max(precision_, 0.5 * context.self().getRadius()));
+            initial_trust_region_radii.front() = precision_;
+            if (warm_start.first && starts.size() > 1) {
+                initial_trust_region_radii[1] = std::max(precision_, warm_start.second.trust_region_radius);
+            }
+        }
+
+        const auto start = Clock::now();
+        const auto max_function_calls = get_max_function_calls_per_start(starts.size(), raster_function_calls);
+
+        if (max_function_calls <= 0) {
+            return raster_best.second;
+        }
+
+        std::vector<std::pair<double, Point>> results(starts.size());
+        std::vector<std::vector<std::pair<Point, double>>> points(starts.size());
+        std::vector<OptimalPositionStats> stats(starts.size());
+
+        const auto minimize_from = [&] (std::size_t index) {
+            auto local = *this;
+            local.points_ = points_ ? &points[index] : nullptr;
+            local.stats_ = stats_ ? &stats[index] : nullptr;
+            results[index] = local.minimize(context, starts[index], initial_trust_region_radii[index],
+                                            max_function_calls, get_position_penalty);
+        };
+
+        for_each_start(starts.size(), minimize_from);
+
+        for (std::size_t i = 0; i < starts.size(); ++i) {
+            if (points_) {
+                points_->insert(points_->end(), points[i].begin(), points[i].end());
+            }
+            if (stats_) {
+                stats_->refine_function_calls += stats[i].refine_function_calls;
+            }
+        }
+
+        if (stats_) {
+            stats_->refine_duration += Clock::now() - start;
+        }
+
+        const auto best = std::min_element(results.begin(), results.end(),
+            [] (const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+        return best->first < raster_best.first ? best->second : raster_best.second;
+    }
+
+#ifdef ELSID_STRATEGY_THREADS
+    std::size_t get_threads_count() const {
+        return thread_pool_ ? thread_pool_->size() + 1 : 1;
+    }
+
+    bool is_parallel() const {
+        return get_threads_count() > 1;
+    }
+
+    template <class Function>
+    void for_each_start(std::size_t count, const Function& function) const {
+        if (!is_parallel()) {
+            for (std::size_t i = 0; i < count; ++i) {
+                function(i);
+            }
+            return;
+        }
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(count - 1);
+
+        for (std::size_t i = 1; i < count; ++i) {
+            futures.push_back(thread_pool_->submit([&, i] { function(i); }));
+        }
+
+        std::exception_ptr error;
+
+        try {
+            function(0);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        for (auto& future : futures) {
+            try {
+                future.get();
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+#else
+    std::size_t get_threads_count() const {
+        return 1;
+    }
+
+    bool is_parallel() const {
+        return false;
+    }
+
+    template <class Function>
+    void for_each_start(std::size_t count, const Function& function) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            function(i);
+        }
+    }
+#endif
 
     template <class Function>
-    Point minimize(const Context& context, const Function& function) const {
-        return Minimize()
-                .initial_trust_region_radius(precision_)
-                .max_function_calls_count(max_function_calls_)
-                .lower_bound(Point(context.self().getRadius() + 1, context.self().getRadius() + 1))
-                .upper_bound(Point(context.world().getWidth() - context.self().getRadius() - 1, context.world().getHeight() - context.self().getRadius() - 1))
-                (get_position(context.self()), function).second;
+    std::pair<double, Point> minimize(const Context& context, const Point& initial, double initial_trust_region_radius,
+                                      long max_function_calls, const Function& function) const {
+        const auto start = Clock::now();
+        long function_calls = 0;
+
+        const auto result = Minimize()
+                .initial_trust_region_radius(initial_trust_region_radius)
+                .max_function_calls_count(max_function_calls)
+                .lower_bound(get_lower_bound(context))
+                .upper_bound(get_upper_bound(context))
+                (initial, [&] (const Point& point) {
+                    const auto value = function(point);
+                    ++function_calls;
+                    if (points_) {
+                        points_->emplace_back(point, value);
+                    }
+                    return value;
+                });
+
+        if (stats_) {
+            stats_->refine_function_calls += function_calls;
+            stats_->refine_duration += Clock::now() - start;
+        }
+
+        return result;
     }
 };
 
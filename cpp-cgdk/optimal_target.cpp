@@ -203,8 +203,9 @@ double GetUnitAttackAbility::operator ()(const model::Wizard& unit) const {
 }
 
 double GetTargetScore::get_distance_probability(const model::Unit& unit) const {
-    const auto distance = get_position(context.self()).distance(get_position(unit));
-    return bounded_line_factor(distance, 2 * get_max_distance_for_unit_candidate(context), 0);
+    const auto ticks = context.reach_time().get_ticks(get_position(unit));
+    const auto max_ticks = 2 * get_max_distance_for_unit_candidate(context) / context.game().getWizardForwardSpeed();
+    return bounded_line_factor(ticks, max_ticks, 0);
 }
 
 double GetTargetScore::get_angle_probability(const model::Unit& unit) const {
@@ -2,6 +2,7 @@
 
 #include "math.hpp"
 
+#include <functional>
 #include <ostream>
 #include <limits>
 #include <iomanip>
@@ -135,3 +136,16 @@ inline std::ostream& operator <<(std::ostream& stream, const PointInt& value) {
 }
 
 }
+
+namespace std {
+
+template <class T>
+struct hash<strategy::BasicPoint<T>> {
+    std::size_t operator ()(const strategy::BasicPoint<T>& value) const {
+        const auto x = std::hash<T>()(value.x());
+        const auto y = std::hash<T>()(value.y());
+        return x ^ (y + 0x9e3779b9 + (x << 6) + (x >> 2));
+    }
+};
+
+}
@@ -0,0 +1,475 @@
+#include "position_penalty_kernels.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace strategy {
+
+namespace {
+
+using simd::ScalarOps;
+using simd::VectorOps;
+
+template <class Ops>
+typename Ops::Value get_distance(typename Ops::Value x, typename Ops::Value y,
+                                 typename Ops::Value other_x, typename Ops::Value other_y) {
+    const auto dx = Ops::sub(other_x, x);
+    const auto dy = Ops::sub(other_y, y);
+    return Ops::sqrt(Ops::add(Ops::mul(dx, dx), Ops::mul(dy, dy)));
+}
+
+template <class Ops>
+typename Ops::Value line_factor(typename Ops::Value value, typename Ops::Value zero_at, typename Ops::Value one_at) {
+    return Ops::div(Ops::sub(value, zero_at), Ops::sub(one_at, zero_at));
+}
+
+template <class Ops>
+typename Ops::Value bounded_line_factor(typename Ops::Value value, typename Ops::Value zero_at, typename Ops::Value one_at) {
+    return Ops::min(Ops::max(line_factor<Ops>(value, zero_at, one_at), Ops::set(0)), Ops::set(1));
+}
+
+template <class Ops, class Function>
+std::size_t for_each_points(const double* xs, const double* ys, std::size_t begin, std::size_t end,
+                            double* result, const Function& function) {
+    auto i = begin;
+    for (; i + Ops::width <= end; i += Ops::width) {
+        Ops::store(function(Ops::load(xs + i), Ops::load(ys + i)), result + i);
+    }
+    return i;
+}
+
+template <class Function>
+void for_each_points(const double* xs, const double* ys, double* result, std::size_t n, const Function& function) {
+    const auto vectorized = for_each_points<VectorOps>(xs, ys, 0, n, result,
+        [&] (auto x, auto y) { return function(VectorOps(), x, y); });
+    for_each_points<ScalarOps>(xs, ys, vectorized, n, result,
+        [&] (auto x, auto y) { return function(ScalarOps(), x, y); });
+}
+
+}
+
+void CollisionBarriers::add(const Point& position, double safe_distance, bool increased) {
+    x_.push_back(position.x());
+    y_.push_back(position.y());
+    safe_distance_.push_back(safe_distance);
+    increased_.push_back(increased);
+}
+
+void CollisionBarriers::get_penalty(const double* xs, const double* ys, double* result, std::size_t n) const {
+    for_each_points(xs, ys, result, n, [&] (auto ops, auto x, auto y) {
+        using Ops = decltype(ops);
+        const auto zero = Ops::set(0);
+        auto max = Ops::set(- std::numeric_limits<double>::max());
+        for (std::size_t i = 0; i < size(); ++i) {
+            const auto distance = get_distance<Ops>(x, y, Ops::set(x_[i]), Ops::set(y_[i]));
+            const auto safe_distance = Ops::set(safe_distance_[i]);
+            const auto base = line_factor<Ops>(distance, safe_distance, zero);
+            if (increased_[i]) {
+                const auto outer = Ops::mul(Ops::set(0.5), line_factor<Ops>(distance, Ops::mul(Ops::set(2.0), safe_distance), zero));
+                max = Ops::max(max, Ops::select(Ops::less(distance, Ops::mul(safe_distance, Ops::set(0.5))), base, outer));
+            } else {
+                max = Ops::max(max, base);
+            }
+        }
+        return max;
+    });
+}
+
+void BonusesPositions::add(const Point& position, double nearest_friend_distance) {
+    x_.push_back(position.x());
+    y_.push_back(position.y());
+    nearest_friend_distance_.push_back(nearest_friend_distance);
+}
+
+void BonusesPositions::get_penalty(const double* xs, const double* ys, double max_distance,
+                                   double* result, std::size_t n) const {
+    for_each_points(xs, ys, result, n, [&] (auto ops, auto x, auto y) {
+        using Ops = decltype(ops);
+        const auto lowest = Ops::set(- std::numeric_limits<double>::max());
+        auto max = lowest;
+        for (std::size_t i = 0; i < size(); ++i) {
+            const auto distance = get_distance<Ops>(x, y, Ops::set(x_[i]), Ops::set(y_[i]));
+            const auto has_nearest_friend = Ops::less(Ops::set(nearest_friend_distance_[i]), distance);
+            const auto penalty = line_factor<Ops>(distance, Ops::set(0), Ops::set(max_distance));
+            max = Ops::max(max, Ops::select(has_nearest_friend, lowest, penalty));
+        }
+        return max;
+    });
+}
+
+void ProjectilesTrajectories::add(const Line& trajectory, double safe_distance) {
+    begin_x_.push_back(trajectory.begin().x());
+    begin_y_.push_back(trajectory.begin().y());
+    end_x_.push_back(trajectory.end().x());
+    end_y_.push_back(trajectory.end().y());
+    safe_distance_.push_back(safe_distance);
+}
+
+void ProjectilesTrajectories::get_penalty(const double* xs, const double* ys, double* result, std::size_t n) const {
+    for_each_points(xs, ys, result, n, [&] (auto ops, auto x, auto y) {
+        using Ops = decltype(ops);
+        const auto zero = Ops::set(0);
+        auto max = Ops::set(- std::numeric_limits<double>::max());
+        for (std::size_t i = 0; i < size(); ++i) {
+            const auto begin_x = Ops::set(begin_x_[i]);
+            const auto begin_y = Ops::set(begin_y_[i]);
+            const auto end_x = Ops::set(end_x_[i]);
+            const auto end_y = Ops::set(end_y_[i]);
+            const auto to_end_x = end_x_[i] - begin_x_[i];
+            const auto to_end_y = end_y_[i] - begin_y_[i];
+            const auto to_end_squared_norm = to_end_x * to_end_x + to_end_y * to_end_y;
+
+            auto nearest_x = begin_x;
+            auto nearest_y = begin_y;
+
+            if (to_end_squared_norm != 0) {
+                const auto to_point_x = Ops::sub(x, begin_x);
+                const auto to_point_y = Ops::sub(y, begin_y);
+                const auto dot = Ops::add(Ops::mul(to_point_x, Ops::set(to_end_x)), Ops::mul(to_point_y, Ops::set(to_end_y)));
+                nearest_x = Ops::add(begin_x, Ops::div(Ops::mul(Ops::set(to_end_x), dot), Ops::set(to_end_squared_norm)));
+                nearest_y = Ops::add(begin_y, Ops::div(Ops::mul(Ops::set(to_end_y), dot), Ops::set(to_end_squared_norm)));
+            }
+
+            const auto nearest_to_end_x = Ops::sub(end_x, nearest_x);
+            const auto nearest_to_end_y = Ops::sub(end_y, nearest_y);
+            const auto nearest_to_begin_x = Ops::sub(begin_x, nearest_x);
+            const auto nearest_to_begin_y = Ops::sub(begin_y, nearest_y);
+            const auto nearest_to_end_square = Ops::add(Ops::mul(nearest_to_end_x, nearest_to_end_x),
+                                                        Ops::mul(nearest_to_end_y, nearest_to_end_y));
+            const auto nearest_to_begin_square = Ops::add(Ops::mul(nearest_to_begin_x, nearest_to_begin_x),
+                                                          Ops::mul(nearest_to_begin_y, nearest_to_begin_y));
+            const auto cos = Ops::div(
+                Ops::add(Ops::mul(nearest_to_begin_x, nearest_to_end_x), Ops::mul(nearest_to_begin_y, nearest_to_end_y)),
+                Ops::mul(Ops::sqrt(nearest_to_begin_square), Ops::sqrt(nearest_to_end_square)));
+            const auto has_point = Ops::any(
+                Ops::any(Ops::equal(nearest_to_end_square, zero), Ops::equal(nearest_to_begin_square, zero)),
+                Ops::less_equal(Ops::abs(Ops::add(Ops::set(1), cos)), Ops::set(1e-8)));
+
+            const auto distance = Ops::select(has_point,
+                get_distance<Ops>(nearest_x, nearest_y, x, y),
+                Ops::min(get_distance<Ops>(begin_x, begin_y, x, y), get_distance<Ops>(end_x, end_y, x, y)));
+
+            const auto safe_distance = Ops::set(safe_distance_[i]);
+            const auto double_safe_distance = Ops::set(2 * safe_distance_[i]);
+            const auto inner = Ops::add(Ops::set(1), Ops::mul(Ops::set(0.1), line_factor<Ops>(distance, safe_distance, zero)));
+            const auto outer = line_factor<Ops>(distance, double_safe_distance, safe_distance);
+
+            max = Ops::max(max, Ops::select(Ops::less(distance, safe_distance), inner, outer));
+        }
+        return max;
+    });
+}
+
+void EliminationTargets::add(const Point& position, double factor) {
+    x_.push_back(position.x());
+    y_.push_back(position.y());
+    factor_.push_back(factor);
+}
+
+void EliminationTargets::get_score(const double* xs, const double* ys, double score_gain_range, double radius,
+                                   double* result, std::size_t n) const {
+    for_each_points(xs, ys, result, n, [&] (auto ops, auto x, auto y) {
+        using Ops = decltype(ops);
+        const auto zero = Ops::set(0);
+        const auto range = Ops::set(score_gain_range);
+        const auto near_range = Ops::set(score_gain_range - radius);
+        auto sum = zero;
+        for (std::size_t i = 0; i < size(); ++i) {
+            const auto distance = get_distance<Ops>(Ops::set(x_[i]), Ops::set(y_[i]), x, y);
+            const auto factor = Ops::set(factor_[i]);
+            const auto inner = Ops::mul(factor, Ops::add(Ops::set(1),
+                Ops::mul(Ops::set(0.1), bounded_line_factor<Ops>(distance, near_range, zero))));
+            const auto outer = Ops::mul(factor, bounded_line_factor<Ops>(distance, range, near_range));
+            sum = Ops::add(sum, Ops::select(Ops::less_equal(distance, near_range), inner, outer));
+        }
+        return sum;
+    });
+}
+
+void SurroundPairs::add(const Point& center, double units_distance, double max_distance) {
+    x_.push_back(center.x());
+    y_.push_back(center.y());
+    units_distance_.push_back(units_distance);
+    max_distance_.push_back(max_distance);
+}
+
+void SurroundPairs::get_penalty(const double* xs, const double* ys, double* result, std::size_t n) const {
+    for_each_points(xs, ys, result, n, [&] (auto ops, auto x, auto y) {
+        using Ops = decltype(ops);
+        const auto zero = Ops::set(0);
+        auto max = Ops::set(- std::numeric_limits<double>::max());
+        for (std::size_t i = 0; i < size(); ++i) {
+            const auto distance = get_distance<Ops>(Ops::set(x_[i]), Ops::set(y_[i]), x, y);
+            const auto units_distance = Ops::set(units_distance_[i]);
+            const auto inner = Ops::add(Ops::set(1), Ops::mul(Ops::set(0.1), line_factor<Ops>(distance, units_distance, zero)));
+            const auto outer = line_factor<Ops>(distance, Ops::set(max_distance_[i]), units_distance);
+            max = Ops::max(max, Ops::select(Ops::less(distance, units_distance), inner, outer));
+        }
+        return max;
+    });
+}
+
+template <class Ops>
+struct UnitsDanger::SelectedAttack {
+    typename Ops::Value range;
+    typename Ops::Value physic_damage;
+    typename Ops::Value magic_damage;
+    typename Ops::Value danger_range;
+    typename Ops::Value permissible_damage;
+};
+
+void UnitsDanger::add_friend(const Point& position, double radius) {
+    friend_x_.push_back(position.x());
+    friend_y_.push_back(position.y());
+    friend_radius_.push_back(radius);
+}
+
+void UnitsDanger::add_attack(const Attack& attack) {
+    attack_max_distance_.push_back(attack.max_distance);
+    attack_range_.push_back(attack.range);
+    attack_physic_damage_.push_back(attack.damage.physic());
+    attack_magic_damage_.push_back(attack.damage.magic());
+    attack_danger_range_.push_back(attack.danger_range);
+    attack_permissible_damage_.push_back(attack.permissible_damage);
+}
+
+void UnitsDanger::add_friend_minion_distance(double distance) {
+    friend_minions_distances_.push_back(distance);
+}
+
+void UnitsDanger::add_friend_wizard_distance(double distance) {
+    friend_wizards_distances_.push_back(distance);
+}
+
+void UnitsDanger::add(const Unit& unit) {
+    x_.push_back(unit.position.x());
+    y_.push_back(unit.position.y());
+    radius_.push_back(unit.radius);
+    min_safe_distance_.push_back(unit.min_safe_distance);
+    attack_ability_.push_back(unit.attack_ability);
+    is_rotating_.push_back(unit.is_rotating);
+    is_minion_.push_back(unit.is_minion);
+    mean_speed_x_.push_back(unit.mean_speed.x());
+    mean_speed_y_.push_back(unit.mean_speed.y());
+    is_faction_base_.push_back(unit.is_faction_base);
+    spawned_minions_safe_distance_.push_back(unit.spawned_minions_safe_distance);
+    angle_.push_back(unit.angle);
+    max_turn_.push_back(unit.max_turn);
+    attacks_end_.push_back(attack_max_distance_.size());
+    friend_minions_end_.push_back(friend_minions_distances_.size());
+    friend_wizards_end_.push_back(friend_wizards_distances_.size());
+}
+
+void UnitsDanger::finish_group() {
+    groups_end_.push_back(size());
+}
+
+void UnitsDanger::get_sum_damage(const double* xs, const double* ys, const Parameters& parameters,
+                                 double* result, std::size_t n) const {
+    for_each_points(xs, ys, result, n, [&] (auto ops, auto x, auto y) {
+        using Ops = decltype(ops);
+        return this->get_sum_damage<Ops>(x, y, parameters);
+    });
+}
+
+void UnitsDanger::get_penalty(const double* xs, const double* ys, const Parameters& parameters,
+                              double* result, std::size_t n) const {
+    for_each_points(xs, ys, result, n, [&] (auto ops, auto x, auto y) {
+        using Ops = decltype(ops);
+        const auto sum_damage = this->get_sum_damage<Ops>(x, y, parameters);
+        auto max = Ops::set(- std::numeric_limits<double>::max());
+        for (std::size_t i = 0; i < this->size(); ++i) {
+            max = Ops::max(max, this->get_danger<Ops>(i, x, y, sum_damage, parameters));
+        }
+        return max;
+    });
+}
+
+template <class Ops>
+UnitsDanger::SelectedAttack<Ops> UnitsDanger::get_attack(std::size_t unit, typename Ops::Value distance) const {
+    auto i = attacks_end_[unit] - 1;
+    SelectedAttack<Ops> result {
+        Ops::set(attack_range_[i]),
+        Ops::set(attack_physic_damage_[i]),
+        Ops::set(attack_magic_damage_[i]),
+        Ops::set(attack_danger_range_[i]),
+        Ops::set(attack_permissible_damage_[i]),
+    };
+    while (i-- > get_begin(attacks_end_, unit)) {
+        const auto in_range = Ops::less_equal(distance, Ops::set(attack_max_distance_[i]));
+        result.range = Ops::select(in_range, Ops::set(attack_range_[i]), result.range);
+        result.physic_damage = Ops::select(in_range, Ops::set(attack_physic_damage_[i]), result.physic_damage);
+        result.magic_damage = Ops::select(in_range, Ops::set(attack_magic_damage_[i]), result.magic_damage);
+        result.danger_range = Ops::select(in_range, Ops::set(attack_danger_range_[i]), result.danger_range);
+        result.permissible_damage = Ops::select(in_range, Ops::set(attack_permissible_damage_[i]), result.permissible_damage);
+    }
+    return result;
+}
+
+template <class Ops>
+typename Ops::Value UnitsDanger::get_sum_damage(typename Ops::Value x, typename Ops::Value y,
+                                                const Parameters& parameters) const {
+    auto sum = Ops::set(0);
+    std::size_t unit = 0;
+    for (const auto group_end : groups_end_) {
+        auto group_sum = Ops::set(0);
+        for (; unit < group_end; ++unit) {
+            group_sum = Ops::add(group_sum, get_damage<Ops>(unit, x, y, parameters));
+        }
+        sum = Ops::add(sum, group_sum);
+    }
+    return Ops::add(sum, Ops::set(parameters.burning_damage));
+}
+
+template <class Ops>
+typename Ops::Value UnitsDanger::get_damage(std::size_t unit, typename Ops::Value x, typename Ops::Value y,
+                                            const Parameters& parameters) const {
+    const auto distance = get_distance<Ops>(x, y, Ops::set(x_[unit]), Ops::set(y_[unit]));
+    const auto attack = get_attack<Ops>(unit, distance);
+    const auto factor = Ops::select(Ops::less_equal(distance, attack.range), Ops::set(1),
+        bounded_line_factor<Ops>(Ops::sub(distance, attack.range), Ops::set(2 * parameters.my_radius), Ops::set(0)));
+    const auto attack_ability = Ops::set(attack_ability_[unit]);
+    const auto turn_factor = is_rotating_[unit] ? get_turn_factor<Ops>(unit, x, y, parameters) : Ops::set(1);
+    const auto physic_damage = Ops::mul(Ops::mul(Ops::mul(factor, attack.physic_damage), attack_ability), turn_factor);
+    const auto magic_damage = Ops::mul(Ops::mul(Ops::mul(factor, attack.magic_damage), attack_ability), turn_factor);
+    const auto reduced_magic_damage = Ops::sub(Ops::mul(magic_damage, Ops::set(parameters.magic_damage_factor)),
+                                               Ops::set(parameters.magic_damage_reduction));
+    const auto damage = Ops::add(physic_damage, reduced_magic_damage);
+
+    if (!parameters.reduce_damage_by_friends) {
+        return damage;
+    }
+
+    const auto nearest_minions_count = count_nearest<Ops>(friend_minions_distances_,
+        get_begin(friend_minions_end_, unit), friend_minions_end_[unit], distance);
+    const auto nearest_wizards_count = count_nearest<Ops>(friend_wizards_distances_,
+        get_begin(friend_wizards_end_, unit), friend_wizards_end_[unit], distance);
+
+    return Ops::div(damage, Ops::add(Ops::add(Ops::set(1), nearest_minions_count), Ops::sqrt(nearest_wizards_count)));
+}
+
+template <class Ops>
+typename Ops::Value UnitsDanger::count_nearest(const std::vector<double>& distances, std::size_t begin, std::size_t end,
+                                               typename Ops::Value distance) const {
+    auto count = Ops::set(0);
+    for (auto i = begin; i < end; ++i) {
+        count = Ops::add(count, Ops::select(Ops::less(Ops::set(distances[i]), distance), Ops::set(1), Ops::set(0)));
+    }
+    return count;
+}
+
+template <class Ops>
+typename Ops::Value UnitsDanger::get_turn_factor(std::size_t unit, typename Ops::Value x, typename Ops::Value y,
+                                                 const Parameters& parameters) const {
+    std::array<double, Ops::width> xs;
+    std::array<double, Ops::width> ys;
+    std::array<double, Ops::width> result;
+    Ops::store(x, xs.data());
+    Ops::store(y, ys.data());
+    for (std::size_t i = 0; i < Ops::width; ++i) {
+        result[i] = get_turn_factor(unit, Point(xs[i], ys[i]), parameters);
+    }
+    return Ops::load(result.data());
+}
+
+double UnitsDanger::get_turn_factor(std::size_t unit, const Point& position, const Parameters& parameters) const {
+    const auto current_angle = angle_[unit];
+    const auto future_direction = position - Point(x_[unit], y_[unit]);
+    const auto future_angle = normalize_angle(future_direction.absolute_rotation() - angle_[unit]);
+    const auto turn = std::max(0.0, std::abs(future_angle - current_angle) - parameters.max_turn_angle);
+    const auto turn_ticks = turn / max_turn_[unit];
+    const auto distance = position.distance(parameters.my_position);
+    const auto strafe_speed = std::ceil(turn_ticks) < parameters.my_hastened_remaining_ticks
+            ? parameters.my_hastened_strafe_speed : parameters.my_strafe_speed;
+    const auto move_ticks = distance / strafe_speed;
+    const auto max_cast_angle = parameters.max_cast_angle;
+    return turn_ticks > move_ticks ? 1.0 - std::max(0.0, future_angle - max_cast_angle) / (M_PI - max_cast_angle) : 1.0;
+}
+
+template <class Ops>
+typename Ops::Value UnitsDanger::get_danger(std::size_t unit, typename Ops::Value x, typename Ops::Value y,
+                                            typename Ops::Value sum_damage, const Parameters& parameters) const {
+    if (is_minion_[unit]) {
+        return get_minion_danger<Ops>(unit, x, y, sum_damage, parameters);
+    }
+
+    const auto base = get_base_danger<Ops>(unit, x, y, sum_damage, parameters);
+
+    if (!is_faction_base_[unit]) {
+        return base;
+    }
+
+    const auto corner_distance = get_distance<Ops>(x, y, Ops::set(parameters.minions_spawn_corner.x()),
+                                                   Ops::set(parameters.minions_spawn_corner.y()));
+    const auto spawned_minions_danger = line_factor<Ops>(corner_distance,
+        Ops::set(spawned_minions_safe_distance_[unit]), Ops::set(0));
+    return Ops::max(base, spawned_minions_danger);
+}
+
+template <class Ops>
+typename Ops::Value UnitsDanger::get_minion_danger(std::size_t unit, typename Ops::Value x, typename Ops::Value y,
+                                                   typename Ops::Value sum_damage, const Parameters& parameters) const {
+    const auto base = get_base_danger<Ops>(unit, x, y, sum_damage, parameters);
+
+    if (friend_radius_.empty()) {
+        return base;
+    }
+
+    const auto time_to_position = Ops::div(get_distance<Ops>(Ops::set(parameters.my_position.x()),
+        Ops::set(parameters.my_position.y()), x, y), Ops::set(parameters.my_max_speed));
+    const auto unit_x = Ops::add(Ops::set(x_[unit]), Ops::mul(Ops::set(mean_speed_x_[unit]), time_to_position));
+    const auto unit_y = Ops::add(Ops::set(y_[unit]), Ops::mul(Ops::set(mean_speed_y_[unit]), time_to_position));
+    const auto distance_to_me = get_distance<Ops>(unit_x, unit_y, x, y);
+    const auto is_near = Ops::less(distance_to_me,
+        Ops::set(parameters.staff_range + radius_[unit] + parameters.my_radius));
+
+    auto nearest_distance = get_distance<Ops>(unit_x, unit_y, Ops::set(friend_x_[0]), Ops::set(friend_y_[0]));
+    auto nearest_radius = Ops::set(friend_radius_[0]);
+    for (std::size_t i = 1; i < friend_radius_.size(); ++i) {
+        const auto distance = get_distance<Ops>(unit_x, unit_y, Ops::set(friend_x_[i]), Ops::set(friend_y_[i]));
+        const auto is_nearer = Ops::less(distance, nearest_distance);
+        nearest_distance = Ops::select(is_nearer, distance, nearest_distance);
+        nearest_radius = Ops::select(is_nearer, Ops::set(friend_radius_[i]), nearest_radius);
+    }
+
+    const auto radius = Ops::set(radius_[unit]);
+    const auto distance_to_nearest = Ops::max(Ops::max(nearest_distance, Ops::add(radius, nearest_radius)),
+                                              Ops::set(radius_[unit] + parameters.staff_range));
+    const auto is_behind_friend = Ops::less(Ops::set(parameters.my_radius), Ops::sub(distance_to_me, distance_to_nearest));
+    const auto behind_friend = line_factor<Ops>(distance_to_me, distance_to_nearest, Ops::set(0));
+
+    return Ops::select(is_near, base, Ops::select(is_behind_friend, behind_friend, base));
+}
+
+template <class Ops>
+typename Ops::Value UnitsDanger::get_base_danger(std::size_t unit, typename Ops::Value x, typename Ops::Value y,
+                                                 typename Ops::Value sum_damage, const Parameters& parameters) const {
+    const auto distance = get_distance<Ops>(x, y, Ops::set(x_[unit]), Ops::set(y_[unit]));
+    const auto attack = get_attack<Ops>(unit, distance);
+    const auto my_max_life = Ops::set(parameters.my_max_life);
+    const auto my_life = Ops::set(parameters.my_life);
+    const auto distance_factor = Ops::div(Ops::mul(Ops::div(Ops::mul(Ops::div(my_max_life, attack.permissible_damage),
+        sum_damage), my_life), my_max_life), my_life);
+    const auto safe_distance = Ops::max(Ops::set(min_safe_distance_[unit]),
+        Ops::add(Ops::set(2 * parameters.my_radius), Ops::mul(distance_factor, attack.danger_range)));
+    return line_factor<Ops>(distance, safe_distance, Ops::set(0));
+}
+
+void get_borders_penalty(const double* xs, const double* ys, double map_size, double radius,
+                         double* result, std::size_t n) {
+    for_each_points(xs, ys, result, n, [&] (auto ops, auto x, auto y) {
+        using Ops = decltype(ops);
+        const auto size = Ops::set(map_size);
+        const auto zero_at = Ops::set(2 * radius + 1);
+        const auto one_at = Ops::set(radius + 1);
+        const auto left = line_factor<Ops>(x, zero_at, one_at);
+        const auto right = line_factor<Ops>(Ops::sub(size, x), zero_at, one_at);
+        const auto top = line_factor<Ops>(y, zero_at, one_at);
+        const auto bottom = line_factor<Ops>(Ops::sub(size, y), zero_at, one_at);
+        return Ops::max(Ops::max(left, right), Ops::max(top, bottom));
+    });
+}
+
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "damage.hpp"
+#include "line.hpp"
+
+#include <vector>
+
+namespace strategy {
+
+class CollisionBarriers {
+public:
+    std::size_t size() const {
+        return safe_distance_.size();
+    }
+
+    void add(const Point& position, double safe_distance, bool increased);
+    void get_penalty(const double* xs, const double* ys, double* result, std::size_t n) const;
+
+private:
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> safe_distance_;
+    std::vector<char> increased_;
+};
+
+class BonusesPositions {
+public:
+    std::size_t size() const {
+        return nearest_friend_distance_.size();
+    }
+
+    void add(const Point& position, double nearest_friend_distance);
+    void get_penalty(const double* xs, const double* ys, double max_distance, double* result, std::size_t n) const;
+
+private:
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> nearest_friend_distance_;
+};
+
+class ProjectilesTrajectories {
+public:
+    std::size_t size() const {
+        return safe_distance_.size();
+    }
+
+    void add(const Line& trajectory, double safe_distance);
+    void get_penalty(const double* xs, const double* ys, double* result, std::size_t n) const;
+
+private:
+    std::vector<double> begin_x_;
+    std::vector<double> begin_y_;
+    std::vector<double> end_x_;
+    std::vector<double> end_y_;
+    std::vector<double> safe_distance_;
+};
+
+class EliminationTargets {
+public:
+    std::size_t size() const {
+        return factor_.size();
+    }
+
+    void add(const Point& position, double factor);
+    void get_score(const double* xs, const double* ys, double score_gain_range, double radius,
+                   double* result, std::size_t n) const;
+
+private:
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> factor_;
+};
+
+class SurroundPairs {
+public:
+    std::size_t size() const {
+        return units_distance_.size();
+    }
+
+    void add(const Point& center, double units_distance, double max_distance);
+    void get_penalty(const double* xs, const double* ys, double* result, std::size_t n) const;
+
+private:
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> units_distance_;
+    std::vector<double> max_distance_;
+};
+
+class UnitsDanger {
+public:
+    struct Parameters {
+        Point my_position;
+        double my_radius;
+        double my_life;
+        double my_max_life;
+        double my_max_speed;
+        double my_strafe_speed;
+        double my_hastened_strafe_speed;
+        double my_hastened_remaining_ticks;
+        double burning_damage;
+        double magic_damage_factor;
+        double magic_damage_reduction;
+        bool reduce_damage_by_friends;
+        double staff_range;
+        double max_turn_angle;
+        double max_cast_angle;
+        Point minions_spawn_corner;
+    };
+
+    struct Attack {
+        double max_distance;
+        double range;
+        Damage damage;
+        double danger_range;
+        double permissible_damage;
+    };
+
+    struct Unit {
+        Point position;
+        double radius;
+        double min_safe_distance;
+        double attack_ability;
+        bool is_rotating;
+        bool is_minion;
+        Point mean_speed;
+        bool is_faction_base;
+        double spawned_minions_safe_distance;
+        double angle;
+        double max_turn;
+    };
+
+    std::size_t size() const {
+        return radius_.size();
+    }
+
+    void add_friend(const Point& position, double radius);
+    void add_attack(const Attack& attack);
+    void add_friend_minion_distance(double distance);
+    void add_friend_wizard_distance(double distance);
+    void add(const Unit& unit);
+    void finish_group();
+    void get_sum_damage(const double* xs, const double* ys, const Parameters& parameters,
+                        double* result, std::size_t n) const;
+    void get_penalty(const double* xs, const double* ys, const Parameters& parameters,
+                     double* result, std::size_t n) const;
+
+private:
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> radius_;
+    std::vector<double> min_safe_distance_;
+    std::vector<double> attack_ability_;
+    std::vector<char> is_rotating_;
+    std::vector<char> is_minion_;
+    std::vector<double> mean_speed_x_;
+    std::vector<double> mean_speed_y_;
+    std::vector<char> is_faction_base_;
+    std::vector<double> spawned_minions_safe_distance_;
+    std::vector<double> angle_;
+    std::vector<double> max_turn_;
+    std::vector<std::size_t> attacks_end_;
+    std::vector<std::size_t> friend_minions_end_;
+    std::vector<std::size_t> friend_wizards_end_;
+    std::vector<std::size_t> groups_end_;
+    std::vector<double> attack_max_distance_;
+    std::vector<double> attack_range_;
+    std::vector<double> attack_physic_damage_;
+    std::vector<double> attack_magic_damage_;
+    std::vector<double> attack_danger_range_;
+    std::vector<double> attack_permissible_damage_;
+    std::vector<double> friend_minions_distances_;
+    std::vector<double> friend_wizards_distances_;
+    std::vector<double> friend_x_;
+    std::vector<double> friend_y_;
+    std::vector<double> friend_radius_;
+
+    template <class Ops>
+    struct SelectedAttack;
+
+    template <class Ops>
+    SelectedAttack<Ops> get_attack(std::size_t unit, typename Ops::Value distance) const;
+
+    template <class Ops>
+    typename Ops::Value get_sum_damage(typename Ops::Value x, typename Ops::Value y, const Parameters& parameters) const;
+
+    template <class Ops>
+    typename Ops::Value get_damage(std::size_t unit, typename Ops::Value x, typename Ops::Value y,
+                                   const Parameters& parameters) const;
+
+    template <class Ops>
+    typename Ops::Value get_turn_factor(std::size_t unit, typename Ops::Value x, typename Ops::Value y,
+                                        const Parameters& parameters) const;
+
+    double get_turn_factor(std::size_t unit, const Point& position, const Parameters& parameters) const;
+
+    template <class Ops>
+    typename Ops::Value get_danger(std::size_t unit, typename Ops::Value x, typename Ops::Value y,
+                                   typename Ops::Value sum_damage, const Parameters& parameters) const;
+
+    template <class Ops>
+    typename Ops::Value get_minion_danger(std::size_t unit, typename Ops::Value x, typename Ops::Value y,
+                                          typename Ops::Value sum_damage, const Parameters& parameters) const;
+
+    template <class Ops>
+    typename Ops::Value get_base_danger(std::size_t unit, typename Ops::Value x, typename Ops::Value y,
+                                        typename Ops::Value sum_damage, const Parameters& parameters) const;
+
+    template <class Ops>
+    typename Ops::Value count_nearest(const std::vector<double>& distances, std::size_t begin, std::size_t end,
+                                      typename Ops::Value distance) const;
+
+    std::size_t get_begin(const std::vector<std::size_t>& ends, std::size_t unit) const {
+        return unit == 0 ? 0 : ends[unit - 1];
+    }
+};
+
+void get_borders_penalty(const double* xs, const double* ys, double map_size, double radius,
+                         double* result, std::size_t n);
+
+}
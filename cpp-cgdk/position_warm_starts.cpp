@@ -0,0 +1,53 @@
+#include "position_warm_starts.hpp"
+
+#include <algorithm>
+
+namespace strategy {
+
+std::pair<bool, PositionWarmStart> PositionWarmStarts::get(const PositionKey& key, Tick tick, const Point& my_position,
+                                                           const Point& target_position,
+                                                           const std::vector<UnitId>& units) const {
+    const auto state = states_.find(key);
+
+    if (state == states_.end() || !is_actual(state->second, tick, my_position, target_position, units)) {
+        return {false, PositionWarmStart()};
+    }
+
+    return {true, state->second.warm_start};
+}
+
+void PositionWarmStarts::update(const PositionKey& key, Tick tick, const Point& my_position,
+                                const Point& target_position, const std::vector<UnitId>& units, const Point& optimum) {
+    for (auto it = states_.begin(); it != states_.end();) {
+        if (it->second.tick + OPTIMAL_POSITION_WARM_START_MAX_AGE < tick) {
+            it = states_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    const auto previous = states_.find(key);
+    const auto shift = previous == states_.end()
+            ? OPTIMAL_POSITION_WARM_START_MAX_TRUST_REGION_RADIUS
+            : optimum.distance(previous->second.warm_start.position);
+    const auto trust_region_radius = std::min(OPTIMAL_POSITION_WARM_START_MAX_TRUST_REGION_RADIUS,
+                                              std::max(OPTIMAL_POSITION_WARM_START_MIN_TRUST_REGION_RADIUS, shift));
+    const PositionWarmStart warm_start {optimum, trust_region_radius};
+
+    if (previous != states_.end() && is_actual(previous->second, tick, my_position, target_position, units)) {
+        previous->second.warm_start = warm_start;
+    } else {
+        states_[key] = State {tick, my_position, target_position, units, warm_start};
+    }
+}
+
+bool PositionWarmStarts::is_actual(const State& state, Tick tick, const Point& my_position,
+                                   const Point& target_position, const std::vector<UnitId>& units) {
+    return state.tick <= tick
+            && tick - state.tick <= OPTIMAL_POSITION_WARM_START_MAX_AGE
+            && state.my_position.distance(my_position) <= OPTIMAL_POSITION_WARM_START_MAX_SHIFT
+            && state.target_position.distance(target_position) <= OPTIMAL_POSITION_WARM_START_MAX_SHIFT
+            && state.units == units;
+}
+
+}
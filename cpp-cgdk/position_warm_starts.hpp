@@ -0,0 +1,62 @@
+#pragma once
+
+#include "point.hpp"
+#include "common.hpp"
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace strategy {
+
+enum class PositionCase {
+    UNDER_FIRE,
+    NO_TARGET,
+    TARGET,
+};
+
+struct PositionKey {
+    PositionCase type;
+    UnitId target_id;
+};
+
+inline bool operator <(const PositionKey& lhs, const PositionKey& rhs) {
+    return std::tie(lhs.type, lhs.target_id) < std::tie(rhs.type, rhs.target_id);
+}
+
+struct PositionWarmStart {
+    Point position;
+    double trust_region_radius;
+};
+
+class PositionWarmStarts {
+public:
+    std::size_t size() const {
+        return states_.size();
+    }
+
+    void clear() {
+        states_.clear();
+    }
+
+    std::pair<bool, PositionWarmStart> get(const PositionKey& key, Tick tick, const Point& my_position,
+                                           const Point& target_position, const std::vector<UnitId>& units) const;
+    void update(const PositionKey& key, Tick tick, const Point& my_position, const Point& target_position,
+                const std::vector<UnitId>& units, const Point& optimum);
+
+private:
+    struct State {
+        Tick tick;
+        Point my_position;
+        Point target_position;
+        std::vector<UnitId> units;
+        PositionWarmStart warm_start;
+    };
+
+    std::map<PositionKey, State> states_;
+
+    static bool is_actual(const State& state, Tick tick, const Point& my_position, const Point& target_position,
+                          const std::vector<UnitId>& units);
+};
+
+}
@@ -0,0 +1,38 @@
+#include "reach_time.hpp"
+#include "optimal_movement.hpp"
+#include "helpers.hpp"
+
+namespace strategy {
+
+ReachTime::ReachTime(const model::Wizard& wizard, const model::Game& game, const FullCache& cache)
+        : source_(get_position(wizard)),
+          hastened_ticks_(get_hastened_remaining_ticks(wizard)),
+          hastened_speed_(make_unit_bounds(wizard, game).max_speed(0)),
+          speed_(make_unit_bounds(wizard, game).max_speed(hastened_ticks_)),
+          field_(game.getMapSize(), REACH_TIME_CELL_SIZE) {
+    const auto blocked = get_blocked_cells(field_, cache, wizard.getRadius());
+    for (FlowField::Cell cell = 0; cell < blocked.size(); ++cell) {
+        if (blocked[cell]) {
+            field_.blocked(cell, true);
+        }
+    }
+    field_.sources({source_});
+}
+
+double ReachTime::get_distance(const Point& position) const {
+    return std::max(source_.distance(position), field_.get_lower_bound(position));
+}
+
+double ReachTime::get_ticks(const Point& position) const {
+    return get_ticks_for_distance(get_distance(position));
+}
+
+double ReachTime::get_ticks_for_distance(double distance) const {
+    const auto hastened_distance = hastened_ticks_ * hastened_speed_;
+    if (distance <= hastened_distance) {
+        return distance / hastened_speed_;
+    }
+    return hastened_ticks_ + (distance - hastened_distance) / speed_;
+}
+
+}
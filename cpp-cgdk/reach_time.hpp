@@ -0,0 +1,31 @@
+#pragma once
+
+#include "flow_field.hpp"
+#include "cache.hpp"
+
+#include "model/Game.h"
+#include "model/Wizard.h"
+
+namespace strategy {
+
+class ReachTime {
+public:
+    ReachTime(const model::Wizard& wizard, const model::Game& game, const FullCache& cache);
+
+    const FlowField& field() const {
+        return field_;
+    }
+
+    double get_distance(const Point& position) const;
+    double get_ticks(const Point& position) const;
+    double get_ticks_for_distance(double distance) const;
+
+private:
+    Point source_;
+    double hastened_ticks_;
+    double hastened_speed_;
+    double speed_;
+    FlowField field_;
+};
+
+}
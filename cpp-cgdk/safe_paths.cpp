@@ -0,0 +1,127 @@
+#include "safe_paths.hpp"
+#include "helpers.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace strategy {
+
+SafePaths::SafePaths(const WorldGraph& graph)
+        : graph_(graph),
+          paths_(graph.graph()) {
+    lines_.reserve(graph.graph().arcs_count());
+    for (WorldGraph::NodeId src = 0; src < graph.graph().size(); ++src) {
+        const auto& src_position = graph.nodes().at(src).position;
+        for (auto arc = graph.graph().arcs_begin(src); arc != graph.graph().arcs_end(src); ++arc) {
+            lines_.emplace_back(src_position, graph.nodes().at(arc->dst).position);
+        }
+    }
+}
+
+void SafePaths::update(const Context& context, WorldGraph::NodeId destination) {
+    const auto& graph = graph_.graph();
+    auto dangers = get_dangers(context);
+    const auto full = self_max_life_ != context.self().getMaxLife() || self_radius_ != context.self().getRadius();
+    std::vector<Circle> changed;
+
+    if (!full) {
+        const auto add_changed = [&] (const auto& from, const auto& to) {
+            for (const auto& v : from) {
+                const auto other = to.find(v.first);
+                if (other == to.end() || other->second.value != v.second.value
+                        || other->second.area.position() != v.second.area.position()
+                        || other->second.area.radius() != v.second.area.radius()) {
+                    changed.push_back(v.second.area);
+                }
+            }
+        };
+        add_changed(dangers_, dangers);
+        add_changed(dangers, dangers_);
+    }
+
+    dangers_ = std::move(dangers);
+    self_max_life_ = context.self().getMaxLife();
+    self_radius_ = context.self().getRadius();
+    updated_arcs_count_ = 0;
+
+    for (std::size_t arc = 0; arc < graph.arcs_count(); ++arc) {
+        const auto& line = lines_[arc];
+        if (full || std::any_of(changed.begin(), changed.end(),
+                                [&] (const auto& area) { return area.has_intersection(line); })) {
+            paths_.weight(arc, graph.arc(arc).weight * (1 + SAFE_PATHS_DANGER_FACTOR * get_danger(line)));
+            ++updated_arcs_count_;
+        }
+    }
+
+    if (!paths_.has_target() || paths_.target() != destination) {
+        paths_.reset(destination);
+    } else {
+        paths_.update();
+    }
+}
+
+WorldGraph::Path SafePaths::get_path(WorldGraph::NodeId src) const {
+    const auto path = paths_.path(src);
+    WorldGraph::Path result {path.length, {}};
+    result.nodes.reserve(path.nodes.size());
+    std::transform(path.nodes.begin(), path.nodes.end(), std::back_inserter(result.nodes),
+        [&] (auto id) { return graph_.nodes().at(id); });
+    return result;
+}
+
+double SafePaths::get_length(const std::vector<WorldGraph::Node>& path) const {
+    const auto& graph = graph_.graph();
+    double result = 0;
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        const auto end = graph.arcs_end(path[i - 1].id);
+        const auto arc = std::find_if(graph.arcs_begin(path[i - 1].id), end,
+            [&] (const auto& v) { return v.dst == path[i].id; });
+        if (arc == end) {
+            return std::numeric_limits<double>::max();
+        }
+        result += paths_.weight(graph.arc_index(arc));
+    }
+    return result;
+}
+
+std::unordered_map<UnitId, SafePaths::Danger> SafePaths::get_dangers(const Context& context) const {
+    const auto& self = context.self();
+    std::unordered_map<UnitId, Danger> result;
+
+    const auto add = [&] (UnitId id, const model::Unit& unit, double attack_range, double damage) {
+        if (is_enemy(unit, self.getFaction())) {
+            result.emplace(id, Danger {Circle(get_position(unit), attack_range + self.getRadius()),
+                                       damage / self.getMaxLife()});
+        }
+    };
+
+    for (const auto& v : get_units<model::Building>(context.cache())) {
+        const auto& unit = v.second.value();
+        add(v.first, unit, unit.getAttackRange(), unit.getDamage());
+    }
+
+    for (const auto& v : get_units<model::Wizard>(context.cache())) {
+        const auto& unit = v.second.value();
+        add(v.first, unit, unit.getCastRange(), context.game().getMagicMissileDirectDamage());
+    }
+
+    for (const auto& v : get_units<model::Minion>(context.cache())) {
+        const auto& unit = v.second.value();
+        add(v.first, unit, get_attack_range(unit, context.game()), unit.getDamage());
+    }
+
+    return result;
+}
+
+double SafePaths::get_danger(const Line& line) const {
+    double result = 0;
+    for (const auto& v : dangers_) {
+        if (v.second.area.has_intersection(line)) {
+            result += v.second.value;
+        }
+    }
+    return result;
+}
+
+}
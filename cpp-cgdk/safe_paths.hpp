@@ -0,0 +1,48 @@
+#pragma once
+
+#include "dynamic_shortest_paths.hpp"
+#include "world_graph.hpp"
+#include "context.hpp"
+#include "circle.hpp"
+#include "line.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+namespace strategy {
+
+class SafePaths {
+public:
+    SafePaths(const WorldGraph& graph);
+
+    const DynamicShortestPaths& paths() const {
+        return paths_;
+    }
+
+    std::size_t updated_arcs_count() const {
+        return updated_arcs_count_;
+    }
+
+    void update(const Context& context, WorldGraph::NodeId destination);
+    WorldGraph::Path get_path(WorldGraph::NodeId src) const;
+    double get_length(const std::vector<WorldGraph::Node>& path) const;
+
+private:
+    struct Danger {
+        Circle area;
+        double value;
+    };
+
+    const WorldGraph& graph_;
+    DynamicShortestPaths paths_;
+    std::vector<Line> lines_;
+    std::unordered_map<UnitId, Danger> dangers_;
+    double self_radius_ = 0;
+    double self_max_life_ = 0;
+    std::size_t updated_arcs_count_ = 0;
+
+    std::unordered_map<UnitId, Danger> get_dangers(const Context& context) const;
+    double get_danger(const Line& line) const;
+};
+
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace strategy {
+namespace simd {
+
+struct ScalarOps {
+    using Value = double;
+    using Mask = bool;
+
+    static constexpr std::size_t width = 1;
+
+    static Value load(const double* value) { return *value; }
+    static Value set(double value) { return value; }
+    static Value add(Value lhs, Value rhs) { return lhs + rhs; }
+    static Value sub(Value lhs, Value rhs) { return lhs - rhs; }
+    static Value mul(Value lhs, Value rhs) { return lhs * rhs; }
+    static Value div(Value lhs, Value rhs) { return lhs / rhs; }
+    static Value min(Value lhs, Value rhs) { return std::min(lhs, rhs); }
+    static Value max(Value lhs, Value rhs) { return std::max(lhs, rhs); }
+    static Value sqrt(Value value) { return std::sqrt(value); }
+    static Value abs(Value value) { return std::abs(value); }
+    static Value select(Mask mask, Value lhs, Value rhs) { return mask ? lhs : rhs; }
+    static Mask less(Value lhs, Value rhs) { return lhs < rhs; }
+    static Mask less_equal(Value lhs, Value rhs) { return lhs <= rhs; }
+    static Mask equal(Value lhs, Value rhs) { return lhs == rhs; }
+    static Mask both(Mask lhs, Mask rhs) { return lhs && rhs; }
+    static Mask any(Mask lhs, Mask rhs) { return lhs || rhs; }
+    static void store(Value value, double* result) { *result = value; }
+    static void store(Mask value, char* result) { *result = value; }
+};
+
+#if defined(__AVX__)
+
+struct VectorOps {
+    using Value = __m256d;
+    using Mask = __m256d;
+
+    static constexpr std::size_t width = 4;
+
+    static Value load(const double* value) { return _mm256_loadu_pd(value); }
+    static Value set(double value) { return _mm256_set1_pd(value); }
+    static Value add(Value lhs, Value rhs) { return _mm256_add_pd(lhs, rhs); }
+    static Value sub(Value lhs, Value rhs) { return _mm256_sub_pd(lhs, rhs); }
+    static Value mul(Value lhs, Value rhs) { return _mm256_mul_pd(lhs, rhs); }
+    static Value div(Value lhs, Value rhs) { return _mm256_div_pd(lhs, rhs); }
+    static Value min(Value lhs, Value rhs) { return _mm256_min_pd(lhs, rhs); }
+    static Value max(Value lhs, Value rhs) { return _mm256_max_pd(lhs, rhs); }
+    static Value sqrt(Value value) { return _mm256_sqrt_pd(value); }
+    static Value abs(Value value) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), value); }
+    static Value select(Mask mask, Value lhs, Value rhs) { return _mm256_blendv_pd(rhs, lhs, mask); }
+    static Mask less(Value lhs, Value rhs) { return _mm256_cmp_pd(lhs, rhs, _CMP_LT_OQ); }
+    static Mask less_equal(Value lhs, Value rhs) { return _mm256_cmp_pd(lhs, rhs, _CMP_LE_OQ); }
+    static Mask equal(Value lhs, Value rhs) { return _mm256_cmp_pd(lhs, rhs, _CMP_EQ_OQ); }
+    static Mask both(Mask lhs, Mask rhs) { return _mm256_and_pd(lhs, rhs); }
+    static Mask any(Mask lhs, Mask rhs) { return _mm256_or_pd(lhs, rhs); }
+    static void store(Value value, double* result) { _mm256_storeu_pd(result, value); }
+
+    static void store(Mask value, char* result) {
+        const auto bits = _mm256_movemask_pd(value);
+        for (std::size_t i = 0; i < width; ++i) {
+            result[i] = (bits >> i) & 1;
+        }
+    }
+};
+
+#elif defined(__SSE2__)
+
+struct VectorOps {
+    using Value = __m128d;
+    using Mask = __m128d;
+
+    static constexpr std::size_t width = 2;
+
+    static Value load(const double* value) { return _mm_loadu_pd(value); }
+    static Value set(double value) { return _mm_set1_pd(value); }
+    static Value add(Value lhs, Value rhs) { return _mm_add_pd(lhs, rhs); }
+    static Value sub(Value lhs, Value rhs) { return _mm_sub_pd(lhs, rhs); }
+    static Value mul(Value lhs, Value rhs) { return _mm_mul_pd(lhs, rhs); }
+    static Value div(Value lhs, Value rhs) { return _mm_div_pd(lhs, rhs); }
+    static Value min(Value lhs, Value rhs) { return _mm_min_pd(lhs, rhs); }
+    static Value max(Value lhs, Value rhs) { return _mm_max_pd(lhs, rhs); }
+    static Value sqrt(Value value) { return _mm_sqrt_pd(value); }
+    static Value abs(Value value) { return _mm_andnot_pd(_mm_set1_pd(-0.0), value); }
+    static Value select(Mask mask, Value lhs, Value rhs) { return _mm_or_pd(_mm_and_pd(mask, lhs), _mm_andnot_pd(mask, rhs)); }
+    static Mask less(Value lhs, Value rhs) { return _mm_cmplt_pd(lhs, rhs); }
+    static Mask less_equal(Value lhs, Value rhs) { return _mm_cmple_pd(lhs, rhs); }
+    static Mask equal(Value lhs, Value rhs) { return _mm_cmpeq_pd(lhs, rhs); }
+    static Mask both(Mask lhs, Mask rhs) { return _mm_and_pd(lhs, rhs); }
+    static Mask any(Mask lhs, Mask rhs) { return _mm_or_pd(lhs, rhs); }
+    static void store(Value value, double* result) { _mm_storeu_pd(result, value); }
+
+    static void store(Mask value, char* result) {
+        const auto bits = _mm_movemask_pd(value);
+        result[0] = bits & 1;
+        result[1] = (bits >> 1) & 1;
+    }
+};
+
+#else
+
+using VectorOps = ScalarOps;
+
+#endif
+
+}
+}
@@ -8,15 +8,15 @@ namespace simulation {
 SimulationStrategy::SimulationStrategy(const Context& context)
         : graph_(context.game()),
           move_to_node_({}),
-          move_to_position_(context, get_position(context.self()), Target()) {
+          move_to_position_(context, get_position(context.self()), Target(), &path_search_storage_) {
 }
 
 void SimulationStrategy::apply(Context &context) {
     if (!move_to_node_.at_end()) {
         if (move_to_node_.next(context)) {
-            move_to_position_ = MoveToPosition(context, move_to_node_.path_node()->position, Target());
+            move_to_position_ = MoveToPosition(context, move_to_node_.path_node()->position, Target(), &path_search_storage_);
         } else {
-            move_to_position_ = MoveToPosition(context, get_position(context.self()), Target());
+            move_to_position_ = MoveToPosition(context, get_position(context.self()), Target(), &path_search_storage_);
         }
     }
 
@@ -38,12 +38,12 @@ void SimulationStrategy::apply(Context &context) {
 }
 
 void SimulationStrategy::move_to_node(const Context &context, WorldGraph::NodeId destination_node_id) {
-    const auto source = get_nearest_node(graph_.nodes(), get_position(context.self()));
+    const auto& source = graph_.get_nearest_node(get_position(context.self()));
     move_to_node_ = MoveToNode(graph_.get_shortest_path(source.id, destination_node_id).nodes);
 }
 
 void SimulationStrategy::move_to_position(const Context& context, const Point& destination, const Target& target) {
-    move_to_position_ = MoveToPosition(context, destination, target);
+    move_to_position_ = MoveToPosition(context, destination, target, &path_search_storage_);
 }
 
 void SimulationStrategy::apply_action(const Action& action) {
@@ -23,6 +23,7 @@ public:
 private:
     const WorldGraph graph_;
     MoveToNode move_to_node_;
+    PathSearchStorage path_search_storage_;
     MoveToPosition move_to_position_;
     Action action_;
 };
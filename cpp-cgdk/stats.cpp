@@ -21,6 +21,20 @@ void Stats::calculate(const Context& context) {
     last_tick_ = context.world().getTickIndex();
     last_life_ = context.self().getLife();
 
+    switch (base_strategy_.path_update()) {
+        case PathUpdate::REUSED:
+            ++path_reuses_count_;
+            break;
+        case PathUpdate::REPLANNED:
+            ++path_replans_count_;
+            break;
+        case PathUpdate::BUILT:
+            break;
+    }
+
+    const auto path_nexts_count = path_reuses_count_ + path_replans_count_;
+    path_reuses_per_nexts_ = double(path_reuses_count_) / double(path_nexts_count ? path_nexts_count : 1);
+
     if (base_strategy_.target().is<model::Building>()) {
         ++buildings_.target_ticks_count;
     } else if (base_strategy_.target().is<model::Minion>()) {
@@ -123,6 +137,7 @@ Stream& Stats::log(Stream& stream) const {
     log_target_casts_per_ticks(stream);
     log_damage_to_me(stream);
     log_deaths_count(stream);
+    log_path_reuses_per_nexts(stream);
     return stream;
 }
 
@@ -203,4 +218,15 @@ Stream& Stats::log_deaths_count(Stream& stream) const {
     return stream << "death count: " << deaths_count_ << " tick: " << prev_tick_ + 1 << '\n';
 }
 
+template <class Stream>
+Stream& Stats::log_path_reuses_per_nexts(Stream& stream) const {
+    return stream << "path_reuses_per_nexts"
+        << " all: "
+        << path_reuses_count_ << "/"
+        << path_reuses_count_ + path_replans_count_ << "="
+        << path_reuses_per_nexts_
+        << " replans: " << path_replans_count_
+        << '\n';
+}
+
 }
@@ -51,6 +51,9 @@ private:
     std::size_t deaths_count_ = 0;
     int prev_tick_ = 0;
     int last_damage_ = 0;
+    std::size_t path_reuses_count_ = 0;
+    std::size_t path_replans_count_ = 0;
+    double path_reuses_per_nexts_ = 0;
 
     template <class Stream>
     Stream& log(Stream& stream) const;
@@ -70,6 +73,9 @@ private:
     template <class Stream>
     Stream& log_deaths_count(Stream& stream) const;
 
+    template <class Stream>
+    Stream& log_path_reuses_per_nexts(Stream& stream) const;
+
     void fill(UnitsStats& stats) const;
 };
 
@@ -0,0 +1,360 @@
+#include "tangent_graph.hpp"
+#include "helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace strategy {
+
+TangentGraph::TangentGraph(double map_size, double inflation, double max_edge_length)
+        : map_size_(map_size),
+          inflation_(inflation),
+          max_edge_length_(max_edge_length),
+          cell_size_(max_edge_length / 2),
+          cells_per_side_(std::size_t(std::ceil(map_size / cell_size_))),
+          cells_(cells_per_side_ * cells_per_side_) {
+}
+
+TangentGraph::TangentGraph(const model::World& world, double inflation, double max_edge_length)
+        : TangentGraph(world.getWidth(), inflation, max_edge_length) {
+    std::vector<Circle> regions;
+
+    const auto add = [&] (const auto& units) {
+        for (const auto& unit : units) {
+            regions.push_back(this->insert_barrier(unit.getId(), Circle(get_position(unit), unit.getRadius())));
+        }
+    };
+
+    add(world.getBuildings());
+    add(world.getTrees());
+
+    update_nodes_near(regions);
+}
+
+void TangentGraph::update(const FullCache& cache) {
+    std::vector<UnitId> removed;
+
+    for (const auto& v : barriers_ids_) {
+        if (!get_units<model::Tree>(cache).count(v.first) && !get_units<model::Building>(cache).count(v.first)) {
+            removed.push_back(v.first);
+        }
+    }
+
+    std::vector<Circle> regions;
+
+    for (const auto id : removed) {
+        regions.push_back(erase_barrier(id));
+    }
+
+    std::size_t added = 0;
+
+    const auto add = [&] (const auto& units) {
+        for (const auto& v : units) {
+            if (added >= TANGENT_GRAPH_MAX_NEW_BARRIERS_PER_UPDATE) {
+                return;
+            }
+            if (!this->has_barrier(v.first)) {
+                const auto& unit = v.second.value();
+                regions.push_back(this->insert_barrier(v.first, Circle(get_position(unit), unit.getRadius())));
+                ++added;
+            }
+        }
+    };
+
+    add(get_units<model::Building>(cache));
+    add(get_units<model::Tree>(cache));
+
+    update_nodes_near(regions);
+}
+
+void TangentGraph::add_barrier(UnitId id, const Circle& circle) {
+    if (has_barrier(id)) {
+        return;
+    }
+
+    update_nodes_near({insert_barrier(id, circle)});
+}
+
+void TangentGraph::remove_barrier(UnitId id) {
+    if (!has_barrier(id)) {
+        return;
+    }
+
+    update_nodes_near({erase_barrier(id)});
+}
+
+bool TangentGraph::has_barrier(UnitId id) const {
+    return barriers_ids_.count(id);
+}
+
+bool TangentGraph::is_visible(const Point& source, const Point& target) const {
+    const Line line(source, target);
+    const Point min(std::min(source.x(), target.x()), std::min(source.y(), target.y()));
+    const Point max(std::max(source.x(), target.x()), std::max(source.y(), target.y()));
+    bool result = true;
+    for_each_barrier(min, max, [&] (std::size_t slot) {
+        const auto& barrier = barriers_[slot].circle;
+        if (result && barrier.position().distance(source) >= barrier.radius()
+                && barrier.position().distance(target) >= barrier.radius()
+                && barrier.has_intersection(line)) {
+            result = false;
+        }
+    });
+    return result;
+}
+
+bool TangentGraph::is_inside_barrier(const Point& position) const {
+    bool result = false;
+    for_each_barrier(position, position, [&] (std::size_t slot) {
+        const auto& barrier = barriers_[slot].circle;
+        result = result || barrier.position().distance(position) < barrier.radius();
+    });
+    return result;
+}
+
+TangentGraph::Path TangentGraph::get_path(const Point& source, const Point& target) const {
+    if (is_inside_barrier(target)) {
+        return Path();
+    }
+
+    if (is_visible(source, target)) {
+        return Path({source, target});
+    }
+
+    const auto source_node = NodeIndex(nodes_.size());
+    const auto target_node = NodeIndex(nodes_.size() + 1);
+    const auto nodes_count = nodes_.size() + 2;
+
+    const auto get_position = [&] (NodeIndex node) {
+        return node == source_node ? source : node == target_node ? target : nodes_[node].position;
+    };
+
+    const auto get_visible_nodes = [&] (const Point& position) {
+        std::vector<Edge> result;
+        for_each_node(position, max_edge_length_, [&] (NodeIndex node, double length) {
+            if (is_visible(position, nodes_[node].position)) {
+                result.push_back(Edge {node, length});
+            }
+        });
+        return result;
+    };
+
+    const auto from_source = get_visible_nodes(source);
+    std::vector<double> to_target(nodes_count, std::numeric_limits<double>::max());
+
+    for (const auto& edge : get_visible_nodes(target)) {
+        to_target[edge.node] = edge.length;
+    }
+
+    std::vector<double> costs(nodes_count, std::numeric_limits<double>::max());
+    std::vector<NodeIndex> came_from(nodes_count, NodeIndex(nodes_count));
+    std::vector<std::pair<double, NodeIndex>> queue;
+    const auto greater = [] (const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; };
+
+    const auto relax = [&] (NodeIndex node, NodeIndex other, double length) {
+        const auto cost = costs[node] + length;
+        if (cost < costs[other]) {
+            costs[other] = cost;
+            came_from[other] = node;
+            queue.emplace_back(cost + get_position(other).distance(target), other);
+            std::push_heap(queue.begin(), queue.end(), greater);
+        }
+    };
+
+    costs[source_node] = 0;
+    queue.emplace_back(source.distance(target), source_node);
+
+    while (!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end(), greater);
+        const auto priority = queue.back().first;
+        const auto node = queue.back().second;
+        queue.pop_back();
+
+        if (node == target_node) {
+            break;
+        }
+
+        if (priority > costs[node] + get_position(node).distance(target)) {
+            continue;
+        }
+
+        if (node == source_node) {
+            for (const auto& edge : from_source) {
+                relax(node, edge.node, edge.length);
+            }
+            continue;
+        }
+
+        for (const auto& edge : edges_[node]) {
+            relax(node, edge.node, edge.length);
+        }
+
+        if (to_target[node] != std::numeric_limits<double>::max()) {
+            relax(node, target_node, to_target[node]);
+        }
+    }
+
+    if (came_from[target_node] == nodes_count) {
+        return Path();
+    }
+
+    Path result;
+    for (auto node = target_node; node != nodes_count; node = came_from[node]) {
+        result.push_back(get_position(node));
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+std::size_t TangentGraph::get_cell_index(double value) const {
+    return std::size_t(std::min(double(cells_per_side_ - 1), std::max(0.0, std::floor(value / cell_size_))));
+}
+
+std::size_t TangentGraph::get_barrier_slot() {
+    if (!free_.empty()) {
+        const auto slot = free_.back();
+        free_.pop_back();
+        return slot;
+    }
+    const auto slot = barriers_.size();
+    barriers_.push_back(Barrier {Circle(), 0});
+    nodes_.resize(nodes_.size() + TANGENT_GRAPH_VERTICES_PER_BARRIER, Node {Point(), false});
+    edges_.resize(edges_.size() + TANGENT_GRAPH_VERTICES_PER_BARRIER);
+    return slot;
+}
+
+template <class Function>
+void TangentGraph::for_each_barrier(const Point& min, const Point& max, const Function& function) const {
+    const auto begin_x = get_cell_index(min.x());
+    const auto end_x = get_cell_index(max.x());
+    const auto begin_y = get_cell_index(min.y());
+    const auto end_y = get_cell_index(max.y());
+    for (auto y = begin_y; y <= end_y; ++y) {
+        for (auto x = begin_x; x <= end_x; ++x) {
+            for (const auto slot : cells_[x + y * cells_per_side_]) {
+                const auto& barrier = barriers_[slot];
+                const auto& center = barrier.circle.position();
+                const auto first_x = std::max(begin_x, get_cell_index(center.x() - barrier.vertex_radius));
+                const auto first_y = std::max(begin_y, get_cell_index(center.y() - barrier.vertex_radius));
+                if (x == first_x && y == first_y) {
+                    function(slot);
+                }
+            }
+        }
+    }
+}
+
+template <class Function>
+void TangentGraph::for_each_node(const Point& position, double max_distance, const Function& function) const {
+    const Point range(max_distance, max_distance);
+    for_each_barrier(position - range, position + range, [&] (std::size_t slot) {
+        for (std::size_t vertex = 0; vertex < TANGENT_GRAPH_VERTICES_PER_BARRIER; ++vertex) {
+            const auto node = NodeIndex(slot * TANGENT_GRAPH_VERTICES_PER_BARRIER + vertex);
+            const auto distance = nodes_[node].position.distance(position);
+            if (nodes_[node].enabled && distance <= max_distance) {
+                function(node, distance);
+            }
+        }
+    });
+}
+
+bool TangentGraph::is_node_enabled(const Point& position) const {
+    return position.x() > inflation_ && position.y() > inflation_
+            && position.x() < map_size_ - inflation_ && position.y() < map_size_ - inflation_
+            && !is_inside_barrier(position);
+}
+
+Circle TangentGraph::insert_barrier(UnitId id, const Circle& circle) {
+    const auto slot = get_barrier_slot();
+    auto& barrier = barriers_[slot];
+    barrier.circle = Circle(circle.position(), circle.radius() + inflation_);
+    barrier.vertex_radius = (barrier.circle.radius() + 1) / std::cos(M_PI / TANGENT_GRAPH_VERTICES_PER_BARRIER);
+    barriers_ids_.emplace(id, slot);
+
+    const auto& center = barrier.circle.position();
+    const auto radius = barrier.vertex_radius;
+    for (auto y = get_cell_index(center.y() - radius); y <= get_cell_index(center.y() + radius); ++y) {
+        for (auto x = get_cell_index(center.x() - radius); x <= get_cell_index(center.x() + radius); ++x) {
+            cells_[x + y * cells_per_side_].push_back(slot);
+        }
+    }
+
+    for (std::size_t vertex = 0; vertex < TANGENT_GRAPH_VERTICES_PER_BARRIER; ++vertex) {
+        const auto angle = 2 * M_PI * double(vertex) / double(TANGENT_GRAPH_VERTICES_PER_BARRIER);
+        nodes_[slot * TANGENT_GRAPH_VERTICES_PER_BARRIER + vertex].position = center + Point(radius, 0).rotated(angle);
+    }
+
+    return Circle(center, radius);
+}
+
+Circle TangentGraph::erase_barrier(UnitId id) {
+    const auto it = barriers_ids_.find(id);
+    const auto slot = it->second;
+    const auto& barrier = barriers_[slot];
+    barriers_ids_.erase(it);
+    free_.push_back(slot);
+
+    const auto& center = barrier.circle.position();
+    const auto radius = barrier.vertex_radius;
+    for (auto y = get_cell_index(center.y() - radius); y <= get_cell_index(center.y() + radius); ++y) {
+        for (auto x = get_cell_index(center.x() - radius); x <= get_cell_index(center.x() + radius); ++x) {
+            auto& cell = cells_[x + y * cells_per_side_];
+            cell.erase(std::remove(cell.begin(), cell.end(), slot), cell.end());
+        }
+    }
+
+    for (std::size_t vertex = 0; vertex < TANGENT_GRAPH_VERTICES_PER_BARRIER; ++vertex) {
+        const auto node = slot * TANGENT_GRAPH_VERTICES_PER_BARRIER + vertex;
+        nodes_[node].enabled = false;
+        edges_[node].clear();
+    }
+
+    return Circle(center, radius);
+}
+
+void TangentGraph::update_nodes_near(const std::vector<Circle>& regions) {
+    std::vector<char> is_affected(nodes_.size(), false);
+    std::vector<NodeIndex> affected;
+
+    for (const auto& region : regions) {
+        const auto max_distance = region.radius() + max_edge_length_;
+        const Point range(max_distance, max_distance);
+        for_each_barrier(region.position() - range, region.position() + range, [&] (std::size_t slot) {
+            for (std::size_t vertex = 0; vertex < TANGENT_GRAPH_VERTICES_PER_BARRIER; ++vertex) {
+                const auto node = NodeIndex(slot * TANGENT_GRAPH_VERTICES_PER_BARRIER + vertex);
+                if (!is_affected[node] && nodes_[node].position.distance(region.position()) <= max_distance) {
+                    is_affected[node] = true;
+                    affected.push_back(node);
+                }
+            }
+        });
+    }
+
+    for (const auto node : affected) {
+        nodes_[node].enabled = is_node_enabled(nodes_[node].position);
+    }
+
+    for (const auto node : affected) {
+        update_node_edges(node);
+    }
+}
+
+void TangentGraph::update_node_edges(NodeIndex node) {
+    auto& edges = edges_[node];
+    edges.clear();
+
+    if (!nodes_[node].enabled) {
+        return;
+    }
+
+    const auto& position = nodes_[node].position;
+
+    for_each_node(position, max_edge_length_, [&] (NodeIndex other, double length) {
+        if (other != node && is_visible(position, nodes_[other].position)) {
+            edges.push_back(Edge {other, length});
+        }
+    });
+}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "circle.hpp"
+#include "cache.hpp"
+#include "common.hpp"
+
+#include "model/World.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace strategy {
+
+class TangentGraph {
+public:
+    using NodeIndex = std::uint32_t;
+    using Path = std::vector<Point>;
+
+    struct Edge {
+        NodeIndex node;
+        double length;
+    };
+
+    TangentGraph(double map_size, double inflation, double max_edge_length);
+    TangentGraph(const model::World& world, double inflation, double max_edge_length);
+
+    std::size_t barriers_count() const {
+        return barriers_ids_.size();
+    }
+
+    std::size_t nodes_count() const {
+        return nodes_.size();
+    }
+
+    const std::vector<std::vector<Edge>>& edges() const {
+        return edges_;
+    }
+
+    void update(const FullCache& cache);
+    void add_barrier(UnitId id, const Circle& circle);
+    void remove_barrier(UnitId id);
+    bool has_barrier(UnitId id) const;
+    bool is_visible(const Point& source, const Point& target) const;
+    bool is_inside_barrier(const Point& position) const;
+    Path get_path(const Point& source, const Point& target) const;
+
+private:
+    struct Barrier {
+        Circle circle;
+        double vertex_radius;
+    };
+
+    struct Node {
+        Point position;
+        bool enabled;
+    };
+
+    double map_size_;
+    double inflation_;
+    double max_edge_length_;
+    double cell_size_;
+    std::size_t cells_per_side_;
+    std::vector<Barrier> barriers_;
+    std::vector<std::size_t> free_;
+    std::unordered_map<UnitId, std::size_t> barriers_ids_;
+    std::vector<std::vector<std::size_t>> cells_;
+    std::vector<Node> nodes_;
+    std::vector<std::vector<Edge>> edges_;
+
+    std::size_t get_cell_index(double value) const;
+    std::size_t get_barrier_slot();
+    template <class Function>
+    void for_each_barrier(const Point& min, const Point& max, const Function& function) const;
+    template <class Function>
+    void for_each_node(const Point& position, double max_distance, const Function& function) const;
+    bool is_node_enabled(const Point& position) const;
+    Circle insert_barrier(UnitId id, const Circle& circle);
+    Circle erase_barrier(UnitId id);
+    void update_nodes_near(const std::vector<Circle>& regions);
+    void update_node_edges(NodeIndex node);
+};
+
+}
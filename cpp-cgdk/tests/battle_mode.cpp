@@ -0,0 +1,84 @@
+#include "common.hpp"
+
+#include <battle_mode.hpp>
+
+#include <gtest/gtest.h>
+
+namespace strategy {
+namespace tests {
+
+using namespace testing;
+
+model::World make_world_with_enemy_wizard(int tick) {
+    const model::Wizard enemy(
+        2, // Id
+        1500, // X
+        1500, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_RENEGADES, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        false, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        60, // RemainingActionCooldownTicks
+        {0, 60, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+    return model::World(
+        tick, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {enemy, SELF}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {} // Trees
+    );
+}
+
+TEST(BattleMode, apply_uses_raster_on_first_tick_with_target_and_warm_start_on_next) {
+    BattleMode battle_mode;
+    FullCache cache;
+    const Profiler profiler;
+
+    const auto first_world = make_world_with_enemy_wizard(0);
+    model::Move first_move;
+    update_cache(cache, first_world);
+    const Context first_context(SELF, first_world, GAME, first_move, cache, cache, profiler, Duration::max());
+    const auto first = battle_mode.apply(first_context);
+    ASSERT_TRUE(first.active());
+    ASSERT_TRUE(first.target().is<model::Wizard>());
+#ifndef ELSID_STRATEGY_THREADS
+    EXPECT_EQ(battle_mode.optimal_position_stats().raster_function_calls,
+              long(OPTIMAL_POSITION_RASTER_SIZE * OPTIMAL_POSITION_RASTER_SIZE + 1));
+#endif
+    EXPECT_GT(battle_mode.optimal_position_stats().refine_function_calls, 0);
+
+    const auto second_world = make_world_with_enemy_wizard(1);
+    model::Move second_move;
+    update_cache(cache, second_world);
+    const Context second_context(SELF, second_world, GAME, second_move, cache, cache, profiler, Duration::max());
+    const auto second = battle_mode.apply(second_context);
+    ASSERT_TRUE(second.active());
+    ASSERT_TRUE(second.target().is<model::Wizard>());
+    EXPECT_EQ(battle_mode.optimal_position_stats().raster_function_calls, 0);
+    EXPECT_GT(battle_mode.optimal_position_stats().refine_function_calls, 0);
+}
+
+} // namespace tests
+} // namespace strategy
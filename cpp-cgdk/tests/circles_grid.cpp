@@ -0,0 +1,51 @@
+#include <circles_grid.hpp>
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace strategy {
+namespace tests {
+
+using namespace testing;
+
+TEST(CirclesGrid, find_candidates_for_empty) {
+    const CirclesGrid grid({}, 100);
+    std::vector<std::size_t> result;
+    grid.find_candidates(Circle(Point(0, 0), 10), Point(100, 100), result);
+    EXPECT_TRUE(result.empty());
+}
+
+TEST(CirclesGrid, find_candidates_returns_sorted_unique_indices) {
+    const CirclesGrid grid({Circle(Point(100, 100), 150), Circle(Point(500, 500), 10), Circle(Point(50, 50), 10)}, 100);
+    std::vector<std::size_t> result;
+    grid.find_candidates(Circle(Point(0, 0), 10), Point(100, 100), result);
+    EXPECT_EQ(result, std::vector<std::size_t>({0, 2}));
+}
+
+TEST(CirclesGrid, find_candidates_contains_all_intersected) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> position(0, 1000);
+    std::uniform_real_distribution<double> radius(10, 50);
+    std::vector<Circle> circles;
+    for (std::size_t i = 0; i < 200; ++i) {
+        circles.emplace_back(Point(position(generator), position(generator)), radius(generator));
+    }
+    const CirclesGrid grid(circles, 100);
+    std::vector<std::size_t> result;
+    for (std::size_t i = 0; i < 100; ++i) {
+        const Circle circle(Point(position(generator), position(generator)), 35);
+        const Point final_position(position(generator), position(generator));
+        grid.find_candidates(circle, final_position, result);
+        for (std::size_t index = 0; index < circles.size(); ++index) {
+            if (circles[index].has_intersection(circle, final_position)) {
+                EXPECT_TRUE(std::binary_search(result.begin(), result.end(), index));
+            }
+        }
+    }
+}
+
+} // namespace tests
+} // namespace strategy
@@ -0,0 +1,53 @@
+#include <corridor.hpp>
+
+#include <gtest/gtest.h>
+
+namespace strategy {
+namespace tests {
+
+using namespace testing;
+
+TEST(Corridor, contains_for_empty) {
+    const Corridor corridor(10);
+    EXPECT_TRUE(corridor.empty());
+    EXPECT_TRUE(corridor.contains(Point(1000, 1000)));
+}
+
+TEST(Corridor, contains) {
+    Corridor corridor(10);
+    corridor.add(Point(0, 0), Point(100, 0));
+    corridor.add(Point(100, 0), Point(100, 100));
+    EXPECT_TRUE(corridor.contains(Point(50, 10)));
+    EXPECT_TRUE(corridor.contains(Point(-10, 0)));
+    EXPECT_TRUE(corridor.contains(Point(95, 50)));
+    EXPECT_FALSE(corridor.contains(Point(50, 11)));
+    EXPECT_FALSE(corridor.contains(Point(-11, 0)));
+    EXPECT_FALSE(corridor.contains(Point(50, 50)));
+}
+
+TEST(Corridor, contains_segment) {
+    Corridor corridor(10);
+    corridor.add(Point(0, 0), Point(100, 0));
+    corridor.add(Point(100, 0), Point(100, 100));
+    EXPECT_TRUE(corridor.contains(Point(0, 5), Point(100, 5)));
+    EXPECT_TRUE(corridor.contains(Point(90, 5), Point(105, 50)));
+    EXPECT_TRUE(corridor.contains(Point(95, 5), Point(95, 95)));
+    EXPECT_TRUE(corridor.contains(Point(50, 5), Point(50, 5)));
+    EXPECT_FALSE(corridor.contains(Point(50, 0), Point(100, 100)));
+    EXPECT_FALSE(corridor.contains(Point(0, 0), Point(100, 100)));
+    EXPECT_FALSE(corridor.contains(Point(0, 20), Point(100, 20)));
+    EXPECT_FALSE(corridor.contains(Point(50, 5), Point(50, 15)));
+}
+
+TEST(Corridor, add_more_than_max_segments) {
+    Corridor corridor(10);
+    for (std::size_t i = 0; i < CORRIDOR_MAX_SEGMENTS; ++i) {
+        corridor.add(Point(100 * i, 0), Point(100 * (i + 1), 0));
+    }
+    EXPECT_EQ(corridor.size(), CORRIDOR_MAX_SEGMENTS);
+    EXPECT_TRUE(corridor.contains(Point(0, 5), Point(100 * CORRIDOR_MAX_SEGMENTS, 5)));
+    EXPECT_THROW(corridor.add(Point(0, 0), Point(0, 100)), std::logic_error);
+}
+
+} // namespace tests
+} // namespace strategy
@@ -0,0 +1,105 @@
+#include <dynamic_shortest_paths.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace strategy {
+namespace tests {
+
+using namespace testing;
+
+Graph make_grid_graph(std::size_t side) {
+    Graph graph(side * side);
+    for (std::size_t y = 0; y < side; ++y) {
+        for (std::size_t x = 0; x < side; ++x) {
+            const auto node = x + y * side;
+            if (x + 1 < side) {
+                graph.arc(node, node + 1, 1);
+                graph.arc(node + 1, node, 1);
+            }
+            if (y + 1 < side) {
+                graph.arc(node, node + side, 1);
+                graph.arc(node + side, node, 1);
+            }
+        }
+    }
+    graph.build();
+    return graph;
+}
+
+TEST(DynamicShortestPaths, reset) {
+    const auto graph = make_grid_graph(3);
+    DynamicShortestPaths paths(graph);
+    EXPECT_FALSE(paths.has_target());
+    paths.reset(8);
+    EXPECT_EQ(paths.target(), 8u);
+    EXPECT_EQ(paths.length(0), 4);
+    EXPECT_EQ(paths.length(8), 0);
+    EXPECT_EQ(paths.updated_nodes_count(), 9u);
+    const auto path = paths.path(0);
+    EXPECT_EQ(path.length, 4);
+    EXPECT_EQ(path.nodes.size(), 5u);
+    EXPECT_EQ(path.nodes.front(), 0u);
+    EXPECT_EQ(path.nodes.back(), 8u);
+    EXPECT_TRUE(paths.path(8).nodes.empty());
+}
+
+TEST(DynamicShortestPaths, update_after_weight_increase_and_decrease) {
+    const auto graph = make_grid_graph(3);
+    DynamicShortestPaths paths(graph);
+    paths.reset(2);
+    EXPECT_EQ(paths.path(0).nodes, std::vector<Graph::Node>({0, 1, 2}));
+    for (auto arc = graph.arcs_begin(1); arc != graph.arcs_end(1); ++arc) {
+        if (arc->dst == 2) {
+            paths.weight(graph.arc_index(arc), 10);
+        }
+    }
+    paths.update();
+    EXPECT_EQ(paths.length(0), 4);
+    EXPECT_EQ(paths.length(1), 3);
+    for (auto arc = graph.arcs_begin(1); arc != graph.arcs_end(1); ++arc) {
+        if (arc->dst == 2) {
+            paths.weight(graph.arc_index(arc), 1);
+        }
+    }
+    paths.update();
+    EXPECT_EQ(paths.path(0).nodes, std::vector<Graph::Node>({0, 1, 2}));
+}
+
+TEST(DynamicShortestPaths, update_equals_reset_for_random_changes) {
+    const auto graph = make_grid_graph(6);
+    DynamicShortestPaths incremental(graph);
+    DynamicShortestPaths full(graph);
+    incremental.reset(0);
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::size_t> arcs(0, graph.arcs_count() - 1);
+    std::uniform_real_distribution<double> weights(0.5, 5);
+    for (int step = 0; step < 100; ++step) {
+        for (int change = 0; change < 3; ++change) {
+            const auto arc = arcs(generator);
+            const auto weight = weights(generator);
+            incremental.weight(arc, weight);
+            full.weight(arc, weight);
+        }
+        incremental.update();
+        full.reset(0);
+        for (Graph::Node node = 0; node < graph.size(); ++node) {
+            ASSERT_NEAR(incremental.length(node), full.length(node), 1e-9) << step << " " << node;
+            const auto path = incremental.path(node);
+            double length = 0;
+            for (std::size_t i = 1; i < path.nodes.size(); ++i) {
+                for (auto arc = graph.arcs_begin(path.nodes[i - 1]); arc != graph.arcs_end(path.nodes[i - 1]); ++arc) {
+                    if (arc->dst == path.nodes[i]) {
+                        length += incremental.weight(graph.arc_index(arc));
+                    }
+                }
+            }
+            ASSERT_NEAR(length, full.length(node), 1e-9) << step << " " << node;
+        }
+        EXPECT_LE(incremental.updated_nodes_count(), graph.size());
+    }
+}
+
+} // namespace tests
+} // namespace strategy
@@ -0,0 +1,60 @@
+#include <flat_hash_map.hpp>
+#include <point.hpp>
+
+#include <gtest/gtest.h>
+
+namespace strategy {
+namespace tests {
+
+using namespace testing;
+
+TEST(FlatHashMap, insert_and_find) {
+    FlatHashMap<PointInt, double> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(PointInt(1, 2)), nullptr);
+    EXPECT_TRUE(map.insert(PointInt(1, 2), 3).second);
+    EXPECT_FALSE(map.insert(PointInt(1, 2), 4).second);
+    ASSERT_NE(map.find(PointInt(1, 2)), nullptr);
+    EXPECT_EQ(*map.find(PointInt(1, 2)), 3);
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(FlatHashMap, grow) {
+    FlatHashMap<PointInt, int> map;
+    for (int i = 0; i < 1000; ++i) {
+        map[PointInt(i, -i)] = i;
+    }
+    EXPECT_EQ(map.size(), 1000u);
+    EXPECT_GE(map.capacity(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_NE(map.find(PointInt(i, -i)), nullptr);
+        EXPECT_EQ(*map.find(PointInt(i, -i)), i);
+    }
+}
+
+TEST(FlatHashMap, clear_keeps_capacity) {
+    FlatHashMap<Point, int> map;
+    for (int i = 0; i < 100; ++i) {
+        map[Point(i, 0.5)] = i;
+    }
+    const auto capacity = map.capacity();
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.capacity(), capacity);
+    EXPECT_EQ(map.find(Point(1, 0.5)), nullptr);
+    map[Point(1, 0.5)] = 42;
+    EXPECT_EQ(*map.find(Point(1, 0.5)), 42);
+}
+
+TEST(FlatHashSet, insert_and_count) {
+    FlatHashSet<Point> set;
+    EXPECT_TRUE(set.insert(Point(1, 2)));
+    EXPECT_FALSE(set.insert(Point(1, 2)));
+    EXPECT_TRUE(set.count(Point(1, 2)));
+    EXPECT_FALSE(set.count(Point(2, 1)));
+    set.clear();
+    EXPECT_FALSE(set.count(Point(1, 2)));
+}
+
+} // namespace tests
+} // namespace strategy
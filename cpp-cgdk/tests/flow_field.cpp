@@ -0,0 +1,117 @@
+#include "common.hpp"
+
+#include <context.hpp>
+#include <flow_field.hpp>
+
+#include <gtest/gtest.h>
+
+namespace strategy {
+namespace tests {
+
+using namespace testing;
+
+TEST(FlowField, distance_without_obstacles) {
+    FlowField field(1000, 50);
+    field.sources({Point(25, 25)});
+    EXPECT_EQ(field.cells_per_side(), 20u);
+    EXPECT_DOUBLE_EQ(field.distance(Point(25, 25)), 0);
+    EXPECT_DOUBLE_EQ(field.distance(Point(525, 25)), 500);
+    EXPECT_DOUBLE_EQ(field.distance(Point(525, 525)), 500 * std::sqrt(2.0));
+    EXPECT_LE(field.get_lower_bound(Point(525, 25)), Point(525, 25).distance(Point(25, 25)));
+}
+
+TEST(FlowField, update_around_wall_matches_full_rebuild) {
+    FlowField incremental(1000, 50);
+    incremental.sources({Point(25, 25)});
+    FlowField full(1000, 50);
+    for (std::size_t y = 0; y < 15; ++y) {
+        const auto cell = 10 + y * incremental.cells_per_side();
+        incremental.blocked(cell, true);
+        full.blocked(cell, true);
+    }
+    full.sources({Point(25, 25)});
+    incremental.update();
+    for (FlowField::Cell cell = 0; cell < 400; ++cell) {
+        EXPECT_DOUBLE_EQ(incremental.distance(cell), full.distance(cell)) << cell;
+    }
+    EXPECT_GT(incremental.distance(Point(575, 25)), 1000);
+    EXPECT_EQ(incremental.distance(Point(525, 25)), std::numeric_limits<double>::max());
+
+    incremental.blocked(10 + 5 * incremental.cells_per_side(), false);
+    incremental.update();
+    EXPECT_GT(incremental.updated_cells_count(), 0u);
+    EXPECT_LT(incremental.updated_cells_count(), 400u);
+    EXPECT_DOUBLE_EQ(incremental.distance(Point(575, 25)), 550 + 250 * std::sqrt(2.0));
+}
+
+TEST(FlowField, get_blocked_cells_keeps_partially_covered_cells) {
+    const std::vector<model::Tree> trees({
+        model::Tree(1, 500, 250, 0, 0, 0, model::FACTION_OTHER, 240, 100, 100, {}),
+        model::Tree(2, 500, 750, 0, 0, 0, model::FACTION_OTHER, 240, 100, 100, {}),
+    });
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        1000, // Width
+        1000, // Height
+        {}, // Players
+        {}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        trees // Trees
+    );
+    FullCache cache;
+    update_cache(cache, world);
+    FlowField field(1000, 50);
+    const auto blocked = get_blocked_cells(field, cache, 0);
+    EXPECT_TRUE(blocked[field.get_cell(Point(500, 250))]);
+    EXPECT_FALSE(blocked[field.get_cell(Point(525, 475))]);
+    EXPECT_FALSE(blocked[field.get_cell(Point(475, 525))]);
+    for (FlowField::Cell cell = 0; cell < blocked.size(); ++cell) {
+        field.blocked(cell, blocked[cell]);
+    }
+    field.sources({Point(100, 500)});
+    EXPECT_LE(field.get_lower_bound(Point(900, 500)), 800);
+}
+
+TEST(FlowFields, get_builds_field_with_single_destination) {
+    const WorldGraph graph(GAME);
+    FlowFields fields(graph, GAME.getMapSize(), GAME.getWizardRadius() + 1);
+    const auto& lane_nodes = graph.lanes_nodes().at(model::LANE_MIDDLE);
+    ASSERT_GE(lane_nodes.size(), 2u);
+    const auto& destination = graph.nodes()[*lane_nodes.begin()];
+    const auto& other = graph.nodes()[*std::next(lane_nodes.begin())];
+    const auto field = fields.get(destination.position);
+    ASSERT_NE(field, nullptr);
+    EXPECT_DOUBLE_EQ(field->distance(destination.position), 0);
+    EXPECT_GT(field->distance(other.position), 0);
+    EXPECT_LE(field->get_lower_bound(other.position), other.position.distance(destination.position));
+    EXPECT_EQ(fields.get(destination.position), field);
+    EXPECT_EQ(fields.get(destination.position + Point(1, 0)), nullptr);
+}
+
+TEST(FlowFields, get_reuses_least_recently_used_field) {
+    const WorldGraph graph(GAME);
+    FlowFields fields(graph, GAME.getMapSize(), GAME.getWizardRadius() + 1);
+    const auto& lane_nodes = graph.lanes_nodes().at(model::LANE_MIDDLE);
+    ASSERT_GT(lane_nodes.size(), FLOW_FIELDS_MAX_COUNT);
+    std::vector<const FlowField*> used;
+    auto node = lane_nodes.begin();
+    for (std::size_t i = 0; i < FLOW_FIELDS_MAX_COUNT; ++i, ++node) {
+        used.push_back(fields.get(graph.nodes()[*node].position));
+        ASSERT_NE(used.back(), nullptr);
+    }
+    EXPECT_EQ(fields.size(), FLOW_FIELDS_MAX_COUNT);
+    EXPECT_EQ(fields.get(graph.nodes()[*lane_nodes.begin()].position), used.front());
+    const auto& destination = graph.nodes()[*node];
+    const auto field = fields.get(destination.position);
+    EXPECT_EQ(fields.size(), FLOW_FIELDS_MAX_COUNT);
+    EXPECT_EQ(field, used[1]);
+    EXPECT_DOUBLE_EQ(field->distance(destination.position), 0);
+    EXPECT_EQ(fields.get(graph.nodes()[*lane_nodes.begin()].position), used.front());
+}
+
+} // namespace tests
+} // namespace strategy
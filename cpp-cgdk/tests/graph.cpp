@@ -0,0 +1,76 @@
+#include <graph.hpp>
+
+#include <gtest/gtest.h>
+
+namespace strategy {
+namespace tests {
+
+using namespace testing;
+
+TEST(Graph, build_adjacency_from_arcs) {
+    Graph graph(3);
+    graph.arc(0, 1, 1);
+    graph.arc(0, 2, 5);
+    graph.arc(2, 1, 2);
+    graph.build();
+    ASSERT_EQ(graph.arcs_end(0) - graph.arcs_begin(0), 2);
+    EXPECT_EQ(graph.arcs_begin(0)[0].dst, 1u);
+    EXPECT_EQ(graph.arcs_begin(0)[1].dst, 2u);
+    EXPECT_EQ(graph.arcs_end(1) - graph.arcs_begin(1), 0);
+    ASSERT_EQ(graph.arcs_end(2) - graph.arcs_begin(2), 1);
+    EXPECT_EQ(graph.arcs_begin(2)->weight, 2);
+    EXPECT_EQ(graph.arcs().get(0, 2), 5);
+}
+
+TEST(Graph, get_shortest_path) {
+    Graph graph(5);
+    graph.arc(0, 1, 1);
+    graph.arc(1, 2, 1);
+    graph.arc(0, 2, 3);
+    graph.arc(2, 3, 1);
+    graph.arc(0, 3, 10);
+    graph.build();
+    const auto path = graph.get_shortest_path(0, 3);
+    EXPECT_EQ(path.length, 3);
+    EXPECT_EQ(path.nodes, std::vector<Graph::Node>({0, 1, 2, 3}));
+}
+
+TEST(Graph, get_shortest_path_to_unreachable_node) {
+    Graph graph(3);
+    graph.arc(0, 1, 1);
+    graph.build();
+    const auto path = graph.get_shortest_path(0, 2);
+    EXPECT_EQ(path.length, 0);
+    EXPECT_TRUE(path.nodes.empty());
+}
+
+TEST(Graph, get_shortest_paths) {
+    Graph graph(5);
+    graph.arc(0, 1, 1);
+    graph.arc(1, 2, 1);
+    graph.arc(0, 2, 3);
+    graph.arc(2, 3, 1);
+    graph.build();
+    const auto tree = graph.get_shortest_paths(0);
+    EXPECT_EQ(tree.source(), 0u);
+    EXPECT_FALSE(tree.has_path(0));
+    EXPECT_EQ(tree.nodes_count(0), 0u);
+    EXPECT_EQ(tree.length(2), 2);
+    EXPECT_EQ(tree.nodes_count(3), 4u);
+    EXPECT_FALSE(tree.has_path(4));
+    EXPECT_EQ(tree.length(4), 0);
+    for (Graph::Node node = 0; node < graph.size(); ++node) {
+        const auto path = graph.get_shortest_path(0, node);
+        EXPECT_EQ(tree.path(node).length, path.length);
+        EXPECT_EQ(tree.path(node).nodes, path.nodes);
+    }
+}
+
+TEST(Graph, get_shortest_path_requires_built_adjacency) {
+    Graph graph(2);
+    graph.arc(0, 1, 1);
+    EXPECT_THROW(graph.get_shortest_path(0, 1), std::logic_error);
+}
+
+} // namespace tests
+} // namespace strategy
@@ -0,0 +1,78 @@
+#include <moving_circles.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace strategy {
+namespace tests {
+
+using namespace testing;
+
+TEST(MovingCircles, has_intersection_for_empty) {
+    const MovingCircles circles;
+    std::vector<char> result;
+    circles.has_intersection(Circle(Point(0, 0), 1), Point(10, 0), result);
+    EXPECT_TRUE(result.empty());
+}
+
+TEST(MovingCircles, has_intersection_with_crossing_paths) {
+    MovingCircles circles;
+    circles.add(Circle(Point(5, -10), 1), Point(5, 10));
+    circles.add(Circle(Point(5, 3), 1), Point(5, 10));
+    circles.add(Circle(Point(20, -10), 1), Point(20, 10));
+    std::vector<char> result;
+    circles.has_intersection(Circle(Point(0, 0), 1), Point(10, 0), result);
+    EXPECT_EQ(result, std::vector<char>({1, 0, 0}));
+}
+
+TEST(MovingCircles, has_intersection_matches_static_circles) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> position(0, 500);
+    std::uniform_real_distribution<double> radius(5, 50);
+    MovingCircles circles;
+    std::vector<Circle> values;
+    for (std::size_t i = 0; i < 103; ++i) {
+        const Circle circle(Point(position(generator), position(generator)), radius(generator));
+        circles.add(circle, circle.position());
+        values.push_back(circle);
+    }
+    std::vector<char> result;
+    for (std::size_t n = 0; n < 50; ++n) {
+        const Circle me(Point(position(generator), position(generator)), 35);
+        const Point final_position(position(generator), position(generator));
+        circles.has_intersection(me, final_position, result);
+        ASSERT_EQ(result.size(), values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            EXPECT_EQ(bool(result[i]), values[i].has_intersection(me, final_position)) << n << " " << i;
+        }
+    }
+}
+
+TEST(MovingCircles, has_intersection_covers_moving_circles) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> position(0, 500);
+    std::uniform_real_distribution<double> radius(5, 50);
+    MovingCircles circles;
+    std::vector<std::pair<Circle, Point>> values;
+    for (std::size_t i = 0; i < 101; ++i) {
+        const Circle circle(Point(position(generator), position(generator)), radius(generator));
+        const Point final_position(position(generator), position(generator));
+        circles.add(circle, final_position);
+        values.emplace_back(circle, final_position);
+    }
+    std::vector<char> result;
+    for (std::size_t n = 0; n < 50; ++n) {
+        const Circle me(Point(position(generator), position(generator)), 35);
+        const Point final_position(position(generator), position(generator));
+        circles.has_intersection(me, final_position, result);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (me.has_intersection(final_position, values[i].first, values[i].second)) {
+                EXPECT_TRUE(result[i]) << n << " " << i;
+            }
+        }
+    }
+}
+
+} // namespace tests
+} // namespace strategy
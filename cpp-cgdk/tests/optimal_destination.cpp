@@ -59,6 +59,59 @@ TEST(get_optimal_destination, for_all_default) {
     EXPECT_EQ(get_optimal_destination(context, graph, model::_LANE_UNKNOWN_, self).id, 2u);
 }
 
+TEST(GetNodeScore, shares_nodes_info_in_tick) {
+    const model::Wizard self(
+        1, // Id
+        200, // X
+        3800, // Y
+        0, // SpeedX
+        0, // SpeedY
+        -0.79, // Angle
+        model::FACTION_ACADEMY, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        true, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {self}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(self, world, GAME, move, cache, cache, profiler, Duration::max());
+    WorldGraph graph(GAME);
+    const GetNodeScore for_unknown_lane(context, graph, model::_LANE_UNKNOWN_, self);
+    const GetNodeScore for_middle_lane(context, graph, model::LANE_MIDDLE, self);
+    EXPECT_EQ(for_unknown_lane.info(), for_middle_lane.info());
+    EXPECT_EQ(context.nodes_info(), for_middle_lane.info());
+    EXPECT_EQ(&for_middle_lane.info()->graph(), &graph);
+}
+
 const model::Building FIRST_MIDDLE_ENEMY_TOWER(
     1, // Id
     4000 - 902, // X
@@ -119,6 +172,31 @@ const model::Building FIRST_BOTTOM_ENEMY_TOWER(
     0 // RemainingActionCooldownTicks
 );
 
+TEST(TowersState, is_immortal) {
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {FIRST_MIDDLE_ENEMY_TOWER, FIRST_TOP_ENEMY_TOWER, FIRST_BOTTOM_ENEMY_TOWER}, // Buildings
+        {} // Trees
+    );
+    FullCache cache;
+    update_cache(cache, world);
+    const TowersState state(world, model::FACTION_ACADEMY, cache);
+    EXPECT_TRUE(state.is_enemy_tower_exists(model::LANE_MIDDLE, TowerNumber::FIRST));
+    EXPECT_FALSE(state.is_enemy_tower_exists(model::LANE_MIDDLE, TowerNumber::SECOND));
+    EXPECT_FALSE(state.is_enemy_tower_exists(model::LANE_TOP, TowerNumber::FIRST));
+    EXPECT_TRUE(state.is_enemy_tower_exists(model::LANE_TOP, TowerNumber::SECOND));
+    EXPECT_FALSE(state.is_immortal(FIRST_MIDDLE_ENEMY_TOWER));
+    EXPECT_FALSE(state.is_immortal(FIRST_TOP_ENEMY_TOWER));
+}
+
 TEST(get_optimal_destination, for_me_with_low_life_at_middle_lane) {
     const model::Wizard self(
         1, // Id
@@ -315,5 +393,53 @@ TEST(get_optimal_destination, for_me_with_low_life_at_bottom_lane) {
     EXPECT_EQ(get_optimal_destination(context, graph, model::_LANE_UNKNOWN_, self).id, 37u);
 }
 
+TEST(WorldGraph, get_shortest_path_from_table) {
+    const WorldGraph graph(GAME);
+    for (const auto& src : graph.nodes()) {
+        const auto tree = graph.get_shortest_paths(src.id);
+        for (const auto& dst : graph.nodes()) {
+            const auto path = graph.get_shortest_path(src.id, dst.id);
+            EXPECT_EQ(path.length, graph.get_shortest_path_length(src.id, dst.id));
+            EXPECT_DOUBLE_EQ(path.length, graph.get_shortest_path_length(dst.id, src.id));
+            EXPECT_EQ(path.nodes.size(), tree.nodes_count(dst.id));
+            if (src.id == dst.id) {
+                EXPECT_TRUE(path.nodes.empty());
+            } else {
+                ASSERT_FALSE(path.nodes.empty());
+                EXPECT_EQ(path.nodes.front().id, src.id);
+                EXPECT_EQ(path.nodes.back().id, dst.id);
+            }
+        }
+    }
+}
+
+TEST(WorldGraph, get_nearest_node) {
+    const WorldGraph graph(GAME);
+    for (double y = 0; y <= GAME.getMapSize(); y += 37) {
+        for (double x = 0; x <= GAME.getMapSize(); x += 37) {
+            const Point position(x, y);
+            const auto expected = std::min_element(graph.nodes().begin(), graph.nodes().end(),
+                [&] (const auto& lhs, const auto& rhs) {
+                    return position.distance(lhs.position) < position.distance(rhs.position);
+                });
+            EXPECT_EQ(graph.get_nearest_node(position).id, expected->id) << x << " " << y;
+        }
+    }
+}
+
+TEST(WorldGraph, for_each_node_visits_all_nodes_in_radius) {
+    const WorldGraph graph(GAME);
+    const Point position(1234, 2345);
+    const double radius = 1200;
+    std::vector<WorldGraph::NodeId> visited;
+    graph.for_each_node(position, radius, [&] (const WorldGraph::Node& node) { visited.push_back(node.id); });
+    for (const auto& node : graph.nodes()) {
+        if (position.distance(node.position) < radius) {
+            EXPECT_EQ(std::count(visited.begin(), visited.end(), node.id), 1) << node.id;
+        }
+    }
+    EXPECT_LT(visited.size(), graph.nodes().size());
+}
+
 }
 }
@@ -76,6 +76,31 @@ TEST(get_tangent_points, all) {
               std::make_pair(Point(109.8019801980198018, 101.9801980198019802), Point(110, 100)));
 }
 
+TEST(DynamicBarriersMotion, position_and_snapshot) {
+    DynamicBarriersMotion motion;
+    motion.add(Point(100, 200), Point(1, -2), 10);
+    motion.add(Point(300, 300), Point(0, 0), 20);
+    EXPECT_EQ(motion.size(), 2u);
+    EXPECT_EQ(motion.position(0, 10), Point(110, 180));
+    EXPECT_EQ(motion.position(1, 10), Point(300, 300));
+    EXPECT_DOUBLE_EQ(motion.circle(0, 5).radius(), 10);
+    const auto snapshot = motion.snapshot(5, 10);
+    ASSERT_EQ(snapshot.size(), 2u);
+    EXPECT_EQ(snapshot[0].circle.position(), Point(105, 190));
+    EXPECT_EQ(snapshot[0].target, Point(110, 180));
+    EXPECT_EQ(snapshot[1].circle.position(), snapshot[1].target);
+}
+
+TEST(get_remaining_path, all) {
+    EXPECT_EQ(get_remaining_path(Path(), Point(1, 1)), Path({Point(1, 1)}));
+    EXPECT_EQ(get_remaining_path(Path({Point(0, 0), Point(10, 0), Point(10, 10)}), Point(5, 1)),
+              Path({Point(5, 1), Point(10, 0), Point(10, 10)}));
+    EXPECT_EQ(get_remaining_path(Path({Point(0, 0), Point(10, 0), Point(10, 10)}), Point(11, 5)),
+              Path({Point(11, 5), Point(10, 10)}));
+    EXPECT_EQ(get_remaining_path(Path({Point(0, 0), Point(10, 0), Point(10, 10)}), Point(10, 10)),
+              Path({Point(10, 10)}));
+}
+
 TEST(GetOptimalPath, with_only_me) {
     const model::World world(
         0, // TickIndex
@@ -100,11 +125,368 @@ TEST(GetOptimalPath, with_only_me) {
     EXPECT_EQ(result, Path({get_position(SELF), target}));
 }
 
-TEST(GetOptimalPath, with_only_me_with_shift) {
+TEST(GetOptimalPath, with_only_me_and_previous_path_far_from_lower_bound) {
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {SELF}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME, move, cache, cache, profiler, Duration::max());
+    const Point target(1200, 1200);
+    const Path previous({get_position(SELF), Point(1000, 1600), Point(1200, 1600), target});
+    EXPECT_TRUE(IsPathValid()(context, previous));
+    const auto result = GetOptimalPath().step_size(3).previous_path(&previous)(context, target);
+    EXPECT_EQ(result, Path({get_position(SELF), target}));
+}
+
+TEST(GetOptimalPath, with_only_me_with_shift) {
+    const model::Wizard self(
+        1, // Id
+        1000.5, // X
+        1000.5, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_ACADEMY, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        true, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {self}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(self, world, GAME,move, cache, cache, profiler, Duration::max());
+    const Point target(1200.3, 1200.3);
+    const auto result = GetOptimalPath().step_size(3)(context, target);
+    EXPECT_EQ(result, Path({get_position(self), target}));
+}
+
+TEST(GetOptimalPath, with_only_me_from_position_near_border) {
+    const model::Wizard self(
+        1, // Id
+        35.01, // X
+        35.01, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_ACADEMY, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        true, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {self}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(self, world, GAME,move, cache, cache, profiler, Duration::max());
+    const Point target(1000, 1000);
+    const auto result = GetOptimalPath().step_size(3)(context, target);
+    EXPECT_EQ(result, Path({get_position(self), target}));
+}
+
+TEST(GetOptimalPath, with_only_me_to_my_position) {
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {SELF}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME,move, cache, cache, profiler, Duration::max());
+    const auto result = GetOptimalPath().step_size(3)(context, get_position(SELF));
+    EXPECT_EQ(result, Path({get_position(SELF)}));
+}
+
+TEST(GetOptimalPath, with_static_barrier) {
+    const model::Wizard self(
+        1, // Id
+        1000, // X
+        1000, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_ACADEMY, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        true, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+    const model::Tree tree(
+        2, // Id
+        1000 + 35 + 5 + 10, // X
+        1000 + 35 + 5 + 10, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_OTHER, // Faction
+        5, // Radius
+        17, // Life
+        17, // MaxLife
+        {} // Statuses
+    );
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {self}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {tree} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME,move, cache, cache, profiler, Duration::max());
+    const Point target(1200, 1200);
+    const auto result = GetOptimalPath().step_size(3)(context, target);
+    ASSERT_FALSE(result.empty());
+    EXPECT_EQ(result.size(), 8u);
+    EXPECT_EQ(result.front(), get_position(self));
+    EXPECT_EQ(result.back(), target);
+    EXPECT_NEAR(length(result), 298.412, 1e-3);
+}
+
+TEST(GetOptimalPath, with_static_barrier_and_limited_time) {
+    const model::Wizard self(
+        1, // Id
+        1000, // X
+        1000, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_ACADEMY, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        true, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+    const model::Tree tree(
+        2, // Id
+        1000 + 35 + 5 + 10, // X
+        1000 + 35 + 5 + 10, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_OTHER, // Faction
+        5, // Radius
+        17, // Life
+        17, // MaxLife
+        {} // Statuses
+    );
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {self}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {tree} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME,move, cache, cache, profiler, Duration(1));
+    const Point target(1200, 1200);
+    const auto result = GetOptimalPath().step_size(3).max_iterations(OPTIMAL_PATH_MAX_ITERATIONS)(context, target);
+    ASSERT_FALSE(result.empty());
+    EXPECT_EQ(result.size(), 8u);
+    EXPECT_EQ(result.front(), get_position(self));
+    EXPECT_EQ(result.back(), target);
+    EXPECT_NEAR(length(result), 298.412, 1e-3);
+    const auto anytime = GetOptimalPath().step_size(3).max_iterations(OPTIMAL_PATH_MAX_ITERATIONS).anytime(true)
+        (context, target);
+    ASSERT_FALSE(anytime.empty());
+    EXPECT_EQ(anytime.back(), target);
+}
+
+TEST(GetOptimalPath, with_static_barrier_and_shared_storage) {
+    const model::Wizard self(
+        1, // Id
+        1000, // X
+        1000, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_ACADEMY, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        true, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+    const model::Tree tree(
+        2, // Id
+        1000 + 35 + 5 + 10, // X
+        1000 + 35 + 5 + 10, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_OTHER, // Faction
+        5, // Radius
+        17, // Life
+        17, // MaxLife
+        {} // Statuses
+    );
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {self}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {tree} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME,move, cache, cache, profiler, Duration::max());
+    PathSearchStorage storage;
+    const auto other = GetOptimalPath().step_size(3).storage(&storage)(context, Point(800, 1200));
+    EXPECT_EQ(other, GetOptimalPath().step_size(3)(context, Point(800, 1200)));
+    const Point target(1200, 1200);
+    const auto result = GetOptimalPath().step_size(3).storage(&storage)(context, target);
+    ASSERT_FALSE(result.empty());
+    EXPECT_EQ(result.size(), 8u);
+    EXPECT_EQ(result.front(), get_position(self));
+    EXPECT_EQ(result.back(), target);
+    EXPECT_NEAR(length(result), 298.412, 1e-3);
+}
+
+TEST(GetOptimalPath, with_static_barrier_and_previous_path) {
     const model::Wizard self(
         1, // Id
-        1000.5, // X
-        1000.5, // Y
+        1000, // X
+        1000, // Y
         0, // SpeedX
         0, // SpeedY
         0, // Angle
@@ -127,6 +509,19 @@ TEST(GetOptimalPath, with_only_me_with_shift) {
         true, // Master
         {} // Messages
     );
+    const model::Tree tree(
+        2, // Id
+        1000 + 35 + 5 + 10, // X
+        1000 + 35 + 5 + 10, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_OTHER, // Faction
+        5, // Radius
+        17, // Life
+        17, // MaxLife
+        {} // Statuses
+    );
     const model::World world(
         0, // TickIndex
         20000, // TickCount
@@ -138,23 +533,40 @@ TEST(GetOptimalPath, with_only_me_with_shift) {
         {}, // Projectiles
         {}, // Bonuses
         {}, // Buildings
-        {} // Trees
+        {tree} // Trees
     );
     model::Move move;
     const Profiler profiler;
     FullCache cache;
     update_cache(cache, world);
-    const Context context(self, world, GAME,move, cache, cache, profiler, Duration::max());
-    const Point target(1200.3, 1200.3);
-    const auto result = GetOptimalPath().step_size(3)(context, target);
-    EXPECT_EQ(result, Path({get_position(self), target}));
+    const Context context(SELF, world, GAME,move, cache, cache, profiler, Duration::max());
+    const Point target(1200, 1200);
+    const auto previous = GetOptimalPath().step_size(3)(context, target);
+    EXPECT_EQ(GetOptimalPath().step_size(3).previous_path(&previous)(context, target), previous);
+    EXPECT_TRUE(IsPathValid()(context, previous));
+    const Path direct({get_position(self), target});
+    EXPECT_FALSE(IsPathValid()(context, direct));
+    const auto result = GetOptimalPath().step_size(3).previous_path(&direct)(context, target);
+    ASSERT_GE(result.size(), 3u);
+    EXPECT_EQ(result.front(), get_position(self));
+    EXPECT_EQ(result.back(), target);
+    for (std::size_t i = 1; i < result.size(); ++i) {
+        EXPECT_FALSE(Circle(get_position(tree), tree.getRadius())
+            .has_intersection(Circle(result[i - 1], self.getRadius()), result[i]));
+    }
+    PathSearchStorage storage;
+    EXPECT_FALSE(IsPathValid().storage(&storage)(context, direct));
+    ASSERT_EQ(storage.path_barriers.static_barriers().circles().size(), 1u);
+    const auto cached_circles = storage.path_barriers.static_barriers().circles().data();
+    EXPECT_EQ(GetOptimalPath().step_size(3).storage(&storage).previous_path(&direct)(context, target), result);
+    EXPECT_EQ(storage.path_barriers.static_barriers().circles().data(), cached_circles);
 }
 
-TEST(GetOptimalPath, with_only_me_from_position_near_border) {
+TEST(GetOptimalPath, with_static_barrier_at_direct_path_and_at_paths_around_it) {
     const model::Wizard self(
         1, // Id
-        35.01, // X
-        35.01, // Y
+        1000, // X
+        1000, // Y
         0, // SpeedX
         0, // SpeedY
         0, // Angle
@@ -177,6 +589,45 @@ TEST(GetOptimalPath, with_only_me_from_position_near_border) {
         true, // Master
         {} // Messages
     );
+    const model::Tree first(
+        2, // Id
+        1000 + 35 + 40 + 100, // X
+        1000, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_OTHER, // Faction
+        40, // Radius
+        17, // Life
+        17, // MaxLife
+        {} // Statuses
+    );
+    const model::Tree second(
+        3, // Id
+        1000 + 35 + 40 + 100, // X
+        1000 - 40 - 80 - 5, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_OTHER, // Faction
+        80, // Radius
+        17, // Life
+        17, // MaxLife
+        {} // Statuses
+    );
+    const model::Tree third(
+        4, // Id
+        1000 + 35 + 40 + 100, // X
+        1000 + 40 + 80 + 5, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_OTHER, // Faction
+        80, // Radius
+        17, // Life
+        17, // MaxLife
+        {} // Statuses
+    );
     const model::World world(
         0, // TickIndex
         20000, // TickCount
@@ -188,42 +639,117 @@ TEST(GetOptimalPath, with_only_me_from_position_near_border) {
         {}, // Projectiles
         {}, // Bonuses
         {}, // Buildings
-        {} // Trees
+        {first, second, third} // Trees
     );
     model::Move move;
     const Profiler profiler;
     FullCache cache;
     update_cache(cache, world);
-    const Context context(self, world, GAME,move, cache, cache, profiler, Duration::max());
-    const Point target(1000, 1000);
+    const Context context(SELF, world, GAME, move, cache, cache, profiler, Duration::max());
+    const Point target(1300, 1000);
     const auto result = GetOptimalPath().step_size(3)(context, target);
-    EXPECT_EQ(result, Path({get_position(self), target}));
+    ASSERT_FALSE(result.empty());
+    EXPECT_EQ(result.size(), 53u);
+    EXPECT_EQ(result.front(), get_position(self));
+    EXPECT_EQ(result.back(), target);
+    EXPECT_NEAR(length(result), 624.30737768171286, 1e-3);
 }
 
-TEST(GetOptimalPath, with_only_me_to_my_position) {
+TEST(GetOptimalPath, with_static_barrier_in_corridor) {
+    const model::Wizard self(
+        1, // Id
+        1000, // X
+        1000, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_ACADEMY, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        true, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+    const model::Tree first(
+        2, // Id
+        1000 + 35 + 40 + 100, // X
+        1000, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_OTHER, // Faction
+        40, // Radius
+        17, // Life
+        17, // MaxLife
+        {} // Statuses
+    );
+    const model::Tree second(
+        3, // Id
+        1000 + 35 + 40 + 100, // X
+        1000 - 40 - 80 - 5, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_OTHER, // Faction
+        80, // Radius
+        17, // Life
+        17, // MaxLife
+        {} // Statuses
+    );
+    const model::Tree third(
+        4, // Id
+        1000 + 35 + 40 + 100, // X
+        1000 + 40 + 80 + 5, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_OTHER, // Faction
+        80, // Radius
+        17, // Life
+        17, // MaxLife
+        {} // Statuses
+    );
     const model::World world(
         0, // TickIndex
         20000, // TickCount
         4000, // Width
         4000, // Height
         {}, // Players
-        {SELF}, // Wizards
+        {self}, // Wizards
         {}, // Minions
         {}, // Projectiles
         {}, // Bonuses
         {}, // Buildings
-        {} // Trees
+        {first, second, third} // Trees
     );
     model::Move move;
     const Profiler profiler;
     FullCache cache;
     update_cache(cache, world);
-    const Context context(SELF, world, GAME,move, cache, cache, profiler, Duration::max());
-    const auto result = GetOptimalPath().step_size(3)(context, get_position(SELF));
-    EXPECT_EQ(result, Path({get_position(SELF)}));
+    const Context context(SELF, world, GAME, move, cache, cache, profiler, Duration::max());
+    const Point target(1300, 1000);
+    const auto expected = GetOptimalPath().step_size(3)(context, target);
+    Corridor wide(300);
+    wide.add(get_position(self), target);
+    EXPECT_EQ(GetOptimalPath().step_size(3).corridor(&wide)(context, target), expected);
+    Corridor narrow(1);
+    narrow.add(get_position(self), target);
+    EXPECT_EQ(GetOptimalPath().step_size(3).corridor(&narrow)(context, target), expected);
 }
 
-TEST(GetOptimalPath, with_static_barrier) {
+TEST(GetOptimalPath, with_static_barrier_in_corridor_around_one_side) {
     const model::Wizard self(
         1, // Id
         1000, // X
@@ -252,13 +778,13 @@ TEST(GetOptimalPath, with_static_barrier) {
     );
     const model::Tree tree(
         2, // Id
-        1000 + 35 + 5 + 10, // X
-        1000 + 35 + 5 + 10, // Y
+        1300, // X
+        1000, // Y
         0, // SpeedX
         0, // SpeedY
         0, // Angle
         model::FACTION_OTHER, // Faction
-        5, // Radius
+        100, // Radius
         17, // Life
         17, // MaxLife
         {} // Statuses
@@ -280,17 +806,30 @@ TEST(GetOptimalPath, with_static_barrier) {
     const Profiler profiler;
     FullCache cache;
     update_cache(cache, world);
-    const Context context(SELF, world, GAME,move, cache, cache, profiler, Duration::max());
-    const Point target(1200, 1200);
-    const auto result = GetOptimalPath().step_size(3)(context, target);
-    ASSERT_FALSE(result.empty());
-    EXPECT_EQ(result.size(), 8u);
-    EXPECT_EQ(result.front(), get_position(self));
-    EXPECT_EQ(result.back(), target);
-    EXPECT_NEAR(length(result), 298.412, 1e-3);
+    const Context context(SELF, world, GAME, move, cache, cache, profiler, Duration::max());
+    const Point target(1600, 1000);
+    PathSearchStorage storage;
+    const auto unbounded = GetOptimalPath().step_size(3).storage(&storage)(context, target);
+    const auto unbounded_steps_count = storage.steps.size();
+    ASSERT_FALSE(unbounded.empty());
+    EXPECT_EQ(unbounded.back(), target);
+    Corridor corridor(150);
+    corridor.add(get_position(self), Point(1300, 1250));
+    corridor.add(Point(1300, 1250), target);
+    std::vector<StepState> steps_states;
+    const auto bounded = GetOptimalPath().step_size(3).storage(&storage).corridor(&corridor)
+        .steps_states(&steps_states)(context, target);
+    ASSERT_FALSE(bounded.empty());
+    EXPECT_EQ(bounded.back(), target);
+    ASSERT_FALSE(steps_states.empty());
+    for (const auto& step_state : steps_states) {
+        EXPECT_TRUE(corridor.contains(step_state.position())) << step_state.position();
+        EXPECT_GE(step_state.position().y(), 1000);
+    }
+    EXPECT_LT(storage.steps.size(), unbounded_steps_count);
 }
 
-TEST(GetOptimalPath, with_static_barrier_at_direct_path_and_at_paths_around_it) {
+TEST(GetOptimalPath, anytime_with_static_barrier_at_direct_path_and_at_paths_around_it) {
     const model::Wizard self(
         1, // Id
         1000, // X
@@ -375,12 +914,23 @@ TEST(GetOptimalPath, with_static_barrier_at_direct_path_and_at_paths_around_it)
     update_cache(cache, world);
     const Context context(SELF, world, GAME, move, cache, cache, profiler, Duration::max());
     const Point target(1300, 1000);
-    const auto result = GetOptimalPath().step_size(3)(context, target);
+    const auto expected = GetOptimalPath().step_size(3)(context, target);
+    PathSearchStorage storage;
+    const auto result = GetOptimalPath().step_size(3).anytime(true).storage(&storage)(context, target);
     ASSERT_FALSE(result.empty());
-    EXPECT_EQ(result.size(), 53u);
     EXPECT_EQ(result.front(), get_position(self));
     EXPECT_EQ(result.back(), target);
-    EXPECT_NEAR(length(result), 624.30737768171286, 1e-3);
+    EXPECT_LE(length(result), length(expected) + 1e-6);
+    const auto closest_static_barriers_count = storage.closest_static_barriers.size();
+    EXPECT_GT(closest_static_barriers_count, 0u);
+    EXPECT_EQ(GetOptimalPath().step_size(3).anytime(true).storage(&storage)(context, target), result);
+    EXPECT_EQ(storage.closest_static_barriers.size(), closest_static_barriers_count);
+    const auto first_weight_only = GetOptimalPath().step_size(3).anytime(true).anytime_time_budget(Duration(0))
+        (context, target);
+    ASSERT_FALSE(first_weight_only.empty());
+    EXPECT_EQ(first_weight_only.front(), get_position(self));
+    EXPECT_EQ(first_weight_only.back(), target);
+    EXPECT_GE(length(first_weight_only), length(result) - 1e-6);
 }
 
 TEST(GetOptimalPath, with_dynamic_barrier_moving_in_same_direction) {
@@ -623,6 +1173,85 @@ TEST(GetOptimalPath, with_dynamic_barrier_moving_in_crossing_direction) {
     EXPECT_NEAR(length(result), 349.772, 1e-3);
 }
 
+TEST(GetOptimalPath, with_dynamic_barrier_reaching_crossing_at_same_tick) {
+    const model::Wizard self(
+        1, // Id
+        1000, // X
+        1000, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_ACADEMY, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        true, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+    const model::Wizard other(
+        2, // Id
+        1100, // X
+        1092, // Y
+        0, // SpeedX
+        -3, // SpeedY
+        0, // Angle
+        model::FACTION_ACADEMY, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        false, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        false, // Master
+        {} // Messages
+    );
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {self, other}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME,move, cache, cache, profiler, Duration::max());
+    const Point target(1200, 1000);
+    const auto result = GetOptimalPath().step_size(3)(context, target);
+    ASSERT_FALSE(result.empty());
+    EXPECT_GT(result.size(), 2u);
+    EXPECT_EQ(result.front(), get_position(self));
+    EXPECT_EQ(result.back(), target);
+}
+
 TEST(GetOptimalPath, with_static_occupier) {
     const model::Wizard self(
         1, // Id
@@ -63,6 +63,61 @@ TEST(GetPositionPenalty, get_elimination_score_for_me_and_enemy_wizard) {
     EXPECT_DOUBLE_EQ(get_position_penalty.get_elimination_score(Point(1000, 1000)), 0.32249090143872688);
 }
 
+TEST(GetPositionPenalty, get_sum_damage_to_me_for_me_and_enemy_wizard) {
+    const model::Wizard enemy(
+        2, // Id
+        1500, // X
+        1000, // Y
+        0, // SpeedX
+        0, // SpeedY
+        M_PI, // Angle
+        model::FACTION_RENEGADES, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        false, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {enemy, SELF}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME, move, cache, cache, profiler, Duration::max());
+    const GetPositionPenalty<model::Wizard> get_position_penalty(context, &enemy, 1000);
+    const GetCurrentDamage get_current_damage {context};
+    const ReduceDamage reduce_damage {context};
+    for (double x = 800; x <= 1480; x += 20) {
+        const Point position(x, 1000);
+        const auto expected = reduce_damage(SELF, get_current_damage(enemy, position)).sum();
+        EXPECT_DOUBLE_EQ(get_position_penalty.get_sum_damage_to_me(position), expected) << position;
+    }
+}
+
 TEST(GetPositionPenalty, get_surround_penalty_for_borders) {
     const model::Wizard self(
         1, // Id
@@ -112,6 +167,161 @@ TEST(GetPositionPenalty, get_surround_penalty_for_borders) {
     EXPECT_DOUBLE_EQ(get_position_penalty.get_surround_penalty(Point(100, 100)), 1.05);
 }
 
+TEST(GetPositionPenalty, evaluate_equals_point_wise_penalty) {
+    const model::Wizard enemy(
+        2, // Id
+        1400, // X
+        1100, // Y
+        0, // SpeedX
+        0, // SpeedY
+        M_PI, // Angle
+        model::FACTION_RENEGADES, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        false, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+    const model::Minion minion(3, 900, 1200, 0, 0, 0, model::FACTION_NEUTRAL, 25, 100, 100, {},
+                               model::MINION_ORC_WOODCUTTER, 400, 12, 60, 0);
+    const model::Tree tree(4, 1100, 900, 0, 0, 0, model::FACTION_OTHER, 50, 100, 100, {});
+    const model::Bonus bonus(5, 1200, 1200, 0, 0, 0, model::FACTION_OTHER, 20, model::BONUS_EMPOWER);
+    const model::Projectile projectile(6, 1300, 1000, -40, 0, M_PI, model::FACTION_RENEGADES, 10,
+                                       model::PROJECTILE_MAGIC_MISSILE, 2, 1);
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {enemy, SELF}, // Wizards
+        {minion}, // Minions
+        {projectile}, // Projectiles
+        {bonus}, // Bonuses
+        {}, // Buildings
+        {tree} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME, move, cache, cache, profiler, Duration::max());
+    const GetPositionPenalty<model::Wizard> get_position_penalty(context, &enemy, 1000);
+    std::vector<double> xs;
+    std::vector<double> ys;
+    for (double x = 600; x <= 1500; x += 30) {
+        for (double y = 700; y <= 1300; y += 30) {
+            xs.push_back(x);
+            ys.push_back(y);
+        }
+    }
+    std::vector<double> values(xs.size());
+    get_position_penalty.evaluate(xs.data(), ys.data(), values.data(), values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const Point position(xs[i], ys[i]);
+        EXPECT_DOUBLE_EQ(values[i], get_position_penalty(position)) << position;
+    }
+}
+
+TEST(GetPositionPenalty, evaluate_equals_point_wise_penalty_for_enemy_minions_and_faction_base) {
+    const model::Wizard friend_wizard(
+        2, // Id
+        900, // X
+        1100, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_ACADEMY, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        2, // OwnerPlayerId
+        false, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        false, // Master
+        {} // Messages
+    );
+    const model::Minion friend_minion(3, 1200, 1000, 0, 0, 0, model::FACTION_ACADEMY, 25, 100, 100, {},
+                                      model::MINION_ORC_WOODCUTTER, 400, 12, 60, 0);
+    const model::Minion enemy_woodcutter(4, 1300, 1000, 0, 0, M_PI, model::FACTION_RENEGADES, 25, 100, 100, {},
+                                         model::MINION_ORC_WOODCUTTER, 400, 12, 60, 0);
+    const model::Minion enemy_fetish(5, 700, 1300, 0, 0, 0, model::FACTION_RENEGADES, 25, 100, 100, {},
+                                     model::MINION_FETISH_BLOWDART, 400, 6, 30, 0);
+    const model::Building enemy_base(
+        6, // Id
+        1600, // X
+        600, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_RENEGADES, // Faction
+        100, // Radius
+        1000, // Life
+        1000, // MaxLife
+        {}, // Statuses
+        model::BUILDING_FACTION_BASE, // Type
+        800, // VisionRange
+        800, // AttackRange
+        48, // Damage
+        240, // CooldownTicks
+        0 // RemainingActionCooldownTicks
+    );
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {friend_wizard, SELF}, // Wizards
+        {friend_minion, enemy_woodcutter, enemy_fetish}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {enemy_base}, // Buildings
+        {} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME, move, cache, cache, profiler, Duration::max());
+    const GetPositionPenalty<model::LivingUnit> get_position_penalty(context, nullptr, 1000);
+    std::vector<double> xs;
+    std::vector<double> ys;
+    for (double x = 500; x <= 1500; x += 30) {
+        for (double y = 600; y <= 1400; y += 30) {
+            xs.push_back(x);
+            ys.push_back(y);
+        }
+    }
+    std::vector<double> values(xs.size());
+    get_position_penalty.evaluate(xs.data(), ys.data(), values.data(), values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const Point position(xs[i], ys[i]);
+        EXPECT_DOUBLE_EQ(values[i], get_position_penalty(position)) << position;
+    }
+}
+
 TEST(GetOptimalPosition, for_me_and_enemy_wizard) {
     const model::Wizard enemy(
         2, // Id
@@ -1242,5 +1452,236 @@ TEST(GetOptimalPosition, for_me_and_enemy_wizard_with_low_life_and_max_cooldown)
     EXPECT_EQ(result, Point(1004.2466403195498, 1012.0168596012713));
 }
 
+
+TEST(GetOptimalPosition, for_me_and_enemy_wizard_from_raster) {
+    const model::Wizard enemy(
+        2, // Id
+        1100, // X
+        1100, // Y
+        0, // SpeedX
+        0, // SpeedY
+        - 3 * M_PI / 4, // Angle
+        model::FACTION_RENEGADES, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        false, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {enemy, SELF}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME, move, cache, cache, profiler, Duration::max());
+    const auto& target = world.getWizards()[0];
+    OptimalPositionStats stats;
+    std::vector<std::pair<Point, double>> points;
+    const auto result = GetOptimalPosition<model::Wizard>()
+            .target(&target)
+            .max_distance(1000)
+            .max_function_calls(1000)
+            .raster_size(16)
+            .refined_cells(3)
+            .stats(&stats)
+            .points(&points)
+            (context);
+    EXPECT_EQ(stats.raster_function_calls, 16 * 16 + 1);
+    EXPECT_GT(stats.refine_function_calls, 0);
+    EXPECT_LE(stats.raster_function_calls + stats.refine_function_calls, 1000);
+    EXPECT_EQ(points.size(), std::size_t(stats.raster_function_calls + stats.refine_function_calls));
+    const GetPositionPenalty<model::Wizard> get_position_penalty(context, &target, 1000);
+    const auto min_raster_penalty = std::min_element(points.begin(), points.begin() + stats.raster_function_calls,
+        [] (const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; })->second;
+    EXPECT_LE(get_position_penalty(result), min_raster_penalty);
+}
+
+
+TEST(GetOptimalPosition, for_me_and_enemy_wizard_from_multiple_starts) {
+    const model::Wizard enemy(
+        2, // Id
+        1100, // X
+        1100, // Y
+        0, // SpeedX
+        0, // SpeedY
+        - 3 * M_PI / 4, // Angle
+        model::FACTION_RENEGADES, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        false, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {enemy, SELF}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME, move, cache, cache, profiler, Duration::max());
+    const auto& target = world.getWizards()[0];
+    const auto single = GetOptimalPosition<model::Wizard>()
+            .target(&target)
+            .max_distance(1000)
+            .max_function_calls(1000)
+            (context);
+    OptimalPositionStats stats;
+    std::vector<std::pair<Point, double>> points;
+    const auto get_sequential = GetOptimalPosition<model::Wizard>()
+            .target(&target)
+            .max_distance(1000)
+            .max_function_calls(4 * 1000)
+            .starts(4)
+            .stats(&stats)
+            .points(&points);
+    EXPECT_EQ(get_sequential.get_max_function_calls_per_start(4), 1000);
+    const auto sequential = get_sequential(context);
+    EXPECT_EQ(stats.raster_function_calls, 0);
+    EXPECT_GT(stats.refine_function_calls, 0);
+    EXPECT_LE(stats.refine_function_calls, 4 * 1000);
+    EXPECT_EQ(points.size(), std::size_t(stats.refine_function_calls));
+    const GetPositionPenalty<model::Wizard> get_position_penalty(context, &target, 1000);
+    EXPECT_LE(get_position_penalty(sequential), get_position_penalty(single));
+#ifdef ELSID_STRATEGY_THREADS
+    ThreadPool pool(3);
+    OptimalPositionStats parallel_stats;
+    const auto get_parallel = GetOptimalPosition<model::Wizard>()
+            .target(&target)
+            .max_distance(1000)
+            .max_function_calls(1000)
+            .starts(4)
+            .thread_pool(&pool)
+            .stats(&parallel_stats);
+    EXPECT_EQ(get_parallel.get_max_function_calls_per_start(4), 1000);
+    const auto parallel = get_parallel(context);
+    EXPECT_EQ(parallel, sequential);
+    EXPECT_EQ(parallel_stats.refine_function_calls, stats.refine_function_calls);
+    ThreadPool half_pool(1);
+    const auto get_half_parallel = GetOptimalPosition<model::Wizard>()
+            .target(&target)
+            .max_distance(1000)
+            .max_function_calls(1000)
+            .starts(4)
+            .thread_pool(&half_pool);
+    EXPECT_EQ(get_half_parallel.get_max_function_calls_per_start(4), 500);
+#endif
+}
+
+
+TEST(GetOptimalPosition, for_me_and_enemy_wizard_from_multiple_starts_seeded_by_raster) {
+    const model::Wizard enemy(
+        2, // Id
+        1100, // X
+        1100, // Y
+        0, // SpeedX
+        0, // SpeedY
+        - 3 * M_PI / 4, // Angle
+        model::FACTION_RENEGADES, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        1, // OwnerPlayerId
+        false, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {enemy, SELF}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {} // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME, move, cache, cache, profiler, Duration::max());
+    const auto& target = world.getWizards()[0];
+    OptimalPositionStats stats;
+    std::vector<std::pair<Point, double>> points;
+    const auto result = GetOptimalPosition<model::Wizard>()
+            .target(&target)
+            .max_distance(1000)
+            .max_function_calls(1000)
+            .raster_size(16)
+            .refined_cells(3)
+            .starts(4)
+            .stats(&stats)
+            .points(&points)
+            (context);
+    EXPECT_EQ(stats.raster_function_calls, 16 * 16 + 1);
+    EXPECT_GT(stats.refine_function_calls, 0);
+    EXPECT_LE(stats.raster_function_calls + stats.refine_function_calls, 1000);
+    EXPECT_EQ(points.size(), std::size_t(stats.raster_function_calls + stats.refine_function_calls));
+    const GetPositionPenalty<model::Wizard> get_position_penalty(context, &target, 1000);
+    const auto min_raster_penalty = std::min_element(points.begin(), points.begin() + stats.raster_function_calls,
+        [] (const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; })->second;
+    EXPECT_LE(get_position_penalty(result), min_raster_penalty);
+}
+
 }
 }
@@ -0,0 +1,90 @@
+#include <position_warm_starts.hpp>
+
+#include <gtest/gtest.h>
+
+namespace strategy {
+namespace tests {
+
+using namespace testing;
+
+TEST(PositionWarmStarts, get_without_update_returns_nothing) {
+    const PositionWarmStarts warm_starts;
+    EXPECT_FALSE(warm_starts.get(PositionKey {PositionCase::NO_TARGET, 0}, 0, Point(100, 100), Point(100, 100), {}).first);
+}
+
+TEST(PositionWarmStarts, get_after_update_returns_optimum) {
+    PositionWarmStarts warm_starts;
+    const PositionKey key {PositionCase::TARGET, 42};
+    warm_starts.update(key, 10, Point(100, 100), Point(500, 500), {}, Point(200, 200));
+    const auto result = warm_starts.get(key, 11, Point(103, 100), Point(500, 497), {});
+    ASSERT_TRUE(result.first);
+    EXPECT_EQ(result.second.position, Point(200, 200));
+    EXPECT_DOUBLE_EQ(result.second.trust_region_radius, OPTIMAL_POSITION_WARM_START_MAX_TRUST_REGION_RADIUS);
+}
+
+TEST(PositionWarmStarts, trust_region_radius_follows_optimum_shift) {
+    PositionWarmStarts warm_starts;
+    const PositionKey key {PositionCase::UNDER_FIRE, 0};
+    warm_starts.update(key, 10, Point(100, 100), Point(100, 100), {}, Point(200, 200));
+    warm_starts.update(key, 11, Point(100, 100), Point(100, 100), {}, Point(203, 204));
+    EXPECT_DOUBLE_EQ(warm_starts.get(key, 12, Point(100, 100), Point(100, 100), {}).second.trust_region_radius, 5);
+    warm_starts.update(key, 12, Point(100, 100), Point(100, 100), {}, Point(203, 204));
+    EXPECT_DOUBLE_EQ(warm_starts.get(key, 13, Point(100, 100), Point(100, 100), {}).second.trust_region_radius,
+                     OPTIMAL_POSITION_WARM_START_MIN_TRUST_REGION_RADIUS);
+}
+
+TEST(PositionWarmStarts, get_for_other_key_returns_nothing) {
+    PositionWarmStarts warm_starts;
+    warm_starts.update(PositionKey {PositionCase::TARGET, 42}, 10, Point(100, 100), Point(500, 500), {}, Point(200, 200));
+    EXPECT_FALSE(warm_starts.get(PositionKey {PositionCase::TARGET, 43}, 10, Point(100, 100), Point(500, 500), {}).first);
+    EXPECT_FALSE(warm_starts.get(PositionKey {PositionCase::NO_TARGET, 42}, 10, Point(100, 100), Point(500, 500), {}).first);
+}
+
+TEST(PositionWarmStarts, get_after_world_change_returns_nothing) {
+    PositionWarmStarts warm_starts;
+    const PositionKey key {PositionCase::TARGET, 42};
+    warm_starts.update(key, 10, Point(100, 100), Point(500, 500), {}, Point(200, 200));
+    EXPECT_FALSE(warm_starts.get(key, 10 + OPTIMAL_POSITION_WARM_START_MAX_AGE + 1, Point(100, 100), Point(500, 500), {}).first);
+    EXPECT_FALSE(warm_starts.get(key, 11, Point(100 + OPTIMAL_POSITION_WARM_START_MAX_SHIFT + 1, 100), Point(500, 500), {}).first);
+    EXPECT_FALSE(warm_starts.get(key, 11, Point(100, 100), Point(500, 500 + OPTIMAL_POSITION_WARM_START_MAX_SHIFT + 1), {}).first);
+}
+
+TEST(PositionWarmStarts, get_after_units_change_returns_nothing) {
+    PositionWarmStarts warm_starts;
+    const PositionKey key {PositionCase::TARGET, 42};
+    warm_starts.update(key, 10, Point(100, 100), Point(500, 500), {1, 42}, Point(200, 200));
+    EXPECT_TRUE(warm_starts.get(key, 11, Point(100, 100), Point(500, 500), {1, 42}).first);
+    EXPECT_FALSE(warm_starts.get(key, 11, Point(100, 100), Point(500, 500), {1, 42, 100}).first);
+    EXPECT_FALSE(warm_starts.get(key, 11, Point(100, 100), Point(500, 500), {42}).first);
+}
+
+TEST(PositionWarmStarts, warm_update_keeps_cold_start_anchor) {
+    PositionWarmStarts warm_starts;
+    const PositionKey key {PositionCase::TARGET, 42};
+    warm_starts.update(key, 10, Point(100, 100), Point(500, 500), {}, Point(200, 200));
+    warm_starts.update(key, 11, Point(140, 100), Point(500, 500), {}, Point(200, 200));
+    EXPECT_TRUE(warm_starts.get(key, 12, Point(140, 100), Point(500, 500), {}).first);
+    EXPECT_FALSE(warm_starts.get(key, 12, Point(180, 100), Point(500, 500), {}).first);
+}
+
+TEST(PositionWarmStarts, get_after_max_age_since_cold_start_returns_nothing) {
+    PositionWarmStarts warm_starts;
+    const PositionKey key {PositionCase::TARGET, 42};
+    for (Tick tick = 10; tick <= 10 + OPTIMAL_POSITION_WARM_START_MAX_AGE; ++tick) {
+        warm_starts.update(key, tick, Point(100, 100), Point(500, 500), {}, Point(200, 200));
+    }
+    EXPECT_FALSE(warm_starts.get(key, 10 + OPTIMAL_POSITION_WARM_START_MAX_AGE + 1, Point(100, 100), Point(500, 500), {}).first);
+}
+
+TEST(PositionWarmStarts, update_removes_outdated_states) {
+    PositionWarmStarts warm_starts;
+    warm_starts.update(PositionKey {PositionCase::TARGET, 42}, 10, Point(100, 100), Point(500, 500), {}, Point(200, 200));
+    warm_starts.update(PositionKey {PositionCase::NO_TARGET, 0}, 11, Point(100, 100), Point(100, 100), {}, Point(200, 200));
+    EXPECT_EQ(warm_starts.size(), 2u);
+    warm_starts.update(PositionKey {PositionCase::NO_TARGET, 0}, 10 + OPTIMAL_POSITION_WARM_START_MAX_AGE + 1,
+                       Point(100, 100), Point(100, 100), {}, Point(200, 200));
+    EXPECT_EQ(warm_starts.size(), 1u);
+}
+
+} // namespace tests
+} // namespace strategy
@@ -0,0 +1,144 @@
+#include "common.hpp"
+
+#include <optimal_target.hpp>
+
+#include <gtest/gtest.h>
+
+namespace strategy {
+namespace tests {
+
+using namespace testing;
+
+TEST(ReachTime, get_ticks_without_obstacles) {
+    FullCache cache;
+    const ReachTime reach_time(SELF, GAME, cache);
+    EXPECT_DOUBLE_EQ(reach_time.get_distance(Point(1000, 1400)), 400);
+    EXPECT_DOUBLE_EQ(reach_time.get_ticks(Point(1000, 1400)), 100);
+}
+
+model::Wizard make_hastened_self() {
+    return model::Wizard(
+        1, // Id
+        1000, // X
+        1000, // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_ACADEMY, // Faction
+        35, // Radius
+        100, // Life
+        100, // MaxLife
+        {model::Status(1, model::STATUS_HASTENED, 1, 1, 10)}, // Statuses
+        1, // OwnerPlayerId
+        true, // Me
+        100, // Mana
+        100, // MaxMana
+        600, // VisionRange
+        500, // CastRange
+        0, // Xp
+        0, // Level
+        {}, // Skills
+        0, // RemainingActionCooldownTicks
+        {0, 0, 0, 0, 0, 0, 0}, // RemainingCooldownTicksByAction
+        true, // Master
+        {} // Messages
+    );
+}
+
+TEST(ReachTime, get_ticks_for_hastened) {
+    const auto self = make_hastened_self();
+    FullCache cache;
+    const ReachTime reach_time(self, GAME, cache);
+    const auto hastened_speed = GAME.getWizardForwardSpeed() * (1 + GAME.getHastenedMovementBonusFactor());
+    EXPECT_DOUBLE_EQ(reach_time.get_ticks(Point(1000, 1000 + 5 * hastened_speed)), 5);
+    EXPECT_DOUBLE_EQ(reach_time.get_ticks(Point(1000, 1000 + 10 * hastened_speed + 40)), 20);
+}
+
+TEST(ReachTime, get_distance_around_trees) {
+    std::vector<model::Tree> trees;
+    for (int i = 0; i < 11; ++i) {
+        trees.push_back(model::Tree(100 + i, 1200, 600 + 80 * i, 0, 0, 0, model::FACTION_OTHER, 50, 100, 100, {}));
+    }
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {SELF}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        trees // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME, move, cache, cache, profiler, Duration::max());
+    EXPECT_DOUBLE_EQ(context.reach_time().get_distance(Point(1000, 800)), 200);
+    EXPECT_GT(context.reach_time().get_distance(Point(1400, 1000)), 2 * 400);
+    EXPECT_TRUE(context.reach_time().field().is_blocked(context.reach_time().field().get_cell(Point(1200, 1000))));
+}
+
+TEST(ReachTime, used_by_target_score_but_not_by_range_filter) {
+    std::vector<model::Tree> trees;
+    for (int i = 0; i < 11; ++i) {
+        trees.push_back(model::Tree(100 + i, 1200, 600 + 80 * i, 0, 0, 0, model::FACTION_OTHER, 50, 100, 100, {}));
+    }
+    const model::Minion minion(3, 1400, 1000, 0, 0, 0, model::FACTION_RENEGADES, 25, 100, 100, {},
+                               model::MINION_ORC_WOODCUTTER, 400, 12, 60, 0);
+    const model::World world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {SELF}, // Wizards
+        {minion}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        trees // Trees
+    );
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME, move, cache, cache, profiler, Duration::max());
+    const IsInMyRange is_in_my_range {context, 400};
+    EXPECT_TRUE(is_in_my_range(minion));
+    const GetTargetScore get_target_score {context};
+    const auto max_ticks = 2 * get_max_distance_for_unit_candidate(context) / GAME.getWizardForwardSpeed();
+    const auto expected = bounded_line_factor(context.reach_time().get_ticks(get_position(minion)), max_ticks, 0);
+    EXPECT_DOUBLE_EQ(get_target_score.get_distance_probability(minion), expected);
+    EXPECT_LT(get_target_score.get_distance_probability(minion),
+              bounded_line_factor(400 / GAME.getWizardForwardSpeed(), max_ticks, 0));
+
+    const auto hastened_self = make_hastened_self();
+    const model::World hastened_world(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {hastened_self}, // Wizards
+        {minion}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        trees // Trees
+    );
+    model::Move hastened_move;
+    FullCache hastened_cache;
+    update_cache(hastened_cache, hastened_world);
+    const Context hastened_context(hastened_self, hastened_world, GAME, hastened_move, hastened_cache, hastened_cache,
+                                   profiler, Duration::max());
+    const GetTargetScore get_hastened_target_score {hastened_context};
+    EXPECT_GT(get_hastened_target_score.get_distance_probability(minion),
+              get_target_score.get_distance_probability(minion));
+}
+
+} // namespace tests
+} // namespace strategy
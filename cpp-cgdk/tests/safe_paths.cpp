@@ -0,0 +1,97 @@
+#include "common.hpp"
+
+#include <safe_paths.hpp>
+
+#include <gtest/gtest.h>
+
+namespace strategy {
+namespace tests {
+
+using namespace testing;
+
+model::World make_world_with_enemy_minion(const Point& position) {
+    const model::Minion minion(
+        2, // Id
+        position.x(), // X
+        position.y(), // Y
+        0, // SpeedX
+        0, // SpeedY
+        0, // Angle
+        model::FACTION_RENEGADES, // Faction
+        25, // Radius
+        100, // Life
+        100, // MaxLife
+        {}, // Statuses
+        model::MINION_ORC_WOODCUTTER, // Type
+        400, // VisionRange
+        12, // Damage
+        60, // CooldownTicks
+        0 // RemainingActionCooldownTicks
+    );
+    return model::World(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {SELF}, // Wizards
+        {minion}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        {} // Trees
+    );
+}
+
+TEST(SafePaths, update_recomputes_only_arcs_near_changed_units) {
+    const WorldGraph graph(GAME);
+    const auto& nodes = graph.nodes();
+    const auto destination = graph.enemy_base();
+    model::Move move;
+    const Profiler profiler;
+
+    const auto before = make_world_with_enemy_minion(nodes[graph.friend_base()].position + Point(200, -200));
+    FullCache before_cache;
+    update_cache(before_cache, before);
+    const Context before_context(SELF, before, GAME, move, before_cache, before_cache, profiler, Duration::max());
+
+    SafePaths incremental(graph);
+    incremental.update(before_context, destination);
+    EXPECT_EQ(incremental.updated_arcs_count(), graph.graph().arcs_count());
+    incremental.update(before_context, destination);
+    EXPECT_EQ(incremental.updated_arcs_count(), 0u);
+
+    const auto after = make_world_with_enemy_minion(nodes[graph.friend_base()].position + Point(400, -400));
+    FullCache after_cache;
+    update_cache(after_cache, after);
+    const Context after_context(SELF, after, GAME, move, after_cache, after_cache, profiler, Duration::max());
+
+    incremental.update(after_context, destination);
+    EXPECT_GT(incremental.updated_arcs_count(), 0u);
+    EXPECT_LT(incremental.updated_arcs_count(), graph.graph().arcs_count());
+
+    SafePaths full(graph);
+    full.update(after_context, destination);
+    for (std::size_t arc = 0; arc < graph.graph().arcs_count(); ++arc) {
+        EXPECT_DOUBLE_EQ(incremental.paths().weight(arc), full.paths().weight(arc)) << arc;
+    }
+    EXPECT_DOUBLE_EQ(incremental.get_path(graph.friend_base()).length, full.get_path(graph.friend_base()).length);
+}
+
+TEST(SafePaths, get_length_uses_current_weights) {
+    const WorldGraph graph(GAME);
+    const auto world = make_world_with_enemy_minion(graph.nodes()[graph.friend_base()].position + Point(200, -200));
+    model::Move move;
+    const Profiler profiler;
+    FullCache cache;
+    update_cache(cache, world);
+    const Context context(SELF, world, GAME, move, cache, cache, profiler, Duration::max());
+    SafePaths safe_paths(graph);
+    safe_paths.update(context, graph.enemy_base());
+    const auto path = safe_paths.get_path(graph.friend_base());
+    ASSERT_GE(path.nodes.size(), 2u);
+    EXPECT_DOUBLE_EQ(safe_paths.get_length(path.nodes), path.length);
+}
+
+} // namespace tests
+} // namespace strategy
@@ -0,0 +1,130 @@
+#include <context.hpp>
+#include <tangent_graph.hpp>
+
+#include <gtest/gtest.h>
+
+namespace strategy {
+namespace tests {
+
+using namespace testing;
+
+TEST(TangentGraph, get_path_without_barriers) {
+    const TangentGraph graph(4000, 36, 400);
+    const auto path = graph.get_path(Point(100, 100), Point(1000, 1000));
+    EXPECT_EQ(path, TangentGraph::Path({Point(100, 100), Point(1000, 1000)}));
+}
+
+TEST(TangentGraph, get_path_around_barrier) {
+    TangentGraph graph(4000, 36, 400);
+    graph.add_barrier(1, Circle(Point(500, 500), 50));
+    EXPECT_EQ(graph.barriers_count(), 1u);
+    const auto path = graph.get_path(Point(300, 300), Point(700, 700));
+    ASSERT_GE(path.size(), 3u);
+    EXPECT_EQ(path.front(), Point(300, 300));
+    EXPECT_EQ(path.back(), Point(700, 700));
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        EXPECT_FALSE(Circle(Point(500, 500), 50 + 36).has_intersection(Line(path[i - 1], path[i])));
+    }
+    double length = 0;
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        length += path[i - 1].distance(path[i]);
+    }
+    EXPECT_LT(length, 1.2 * Point(300, 300).distance(Point(700, 700)));
+}
+
+TEST(TangentGraph, get_path_to_point_inside_barrier) {
+    TangentGraph graph(4000, 36, 400);
+    graph.add_barrier(1, Circle(Point(500, 500), 50));
+    EXPECT_EQ(graph.get_path(Point(300, 300), Point(500, 500)), TangentGraph::Path());
+}
+
+TEST(TangentGraph, remove_barrier_restores_direct_path) {
+    TangentGraph graph(4000, 36, 400);
+    graph.add_barrier(1, Circle(Point(500, 500), 50));
+    graph.add_barrier(2, Circle(Point(800, 800), 50));
+    graph.remove_barrier(1);
+    EXPECT_FALSE(graph.has_barrier(1));
+    EXPECT_TRUE(graph.has_barrier(2));
+    EXPECT_EQ(graph.get_path(Point(300, 300), Point(700, 700)),
+              TangentGraph::Path({Point(300, 300), Point(700, 700)}));
+}
+
+TEST(TangentGraph, edges_stay_symmetric_after_updates) {
+    TangentGraph graph(4000, 36, 400);
+    graph.add_barrier(1, Circle(Point(500, 500), 50));
+    graph.add_barrier(2, Circle(Point(650, 500), 30));
+    graph.add_barrier(3, Circle(Point(500, 700), 40));
+    graph.remove_barrier(2);
+    graph.add_barrier(4, Circle(Point(700, 600), 20));
+    for (std::size_t node = 0; node < graph.nodes_count(); ++node) {
+        for (const auto& edge : graph.edges()[node]) {
+            const auto& reverse = graph.edges()[edge.node];
+            EXPECT_TRUE(std::any_of(reverse.begin(), reverse.end(),
+                [&] (const auto& v) { return v.node == node; }));
+        }
+    }
+    const auto path = graph.get_path(Point(300, 500), Point(900, 500));
+    ASSERT_GE(path.size(), 2u);
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        EXPECT_TRUE(graph.is_visible(path[i - 1], path[i]));
+    }
+}
+
+model::World make_world_with_trees(std::size_t count) {
+    std::vector<model::Tree> trees;
+    for (std::size_t i = 0; i < count; ++i) {
+        trees.push_back(model::Tree(100 + i, 300 + 150 * (i % 8), 300 + 150 * (i / 8), 0, 0, 0, model::FACTION_OTHER,
+                                    20 + 5 * (i % 3), 100, 100, {}));
+    }
+    return model::World(
+        0, // TickIndex
+        20000, // TickCount
+        4000, // Width
+        4000, // Height
+        {}, // Players
+        {}, // Wizards
+        {}, // Minions
+        {}, // Projectiles
+        {}, // Bonuses
+        {}, // Buildings
+        trees // Trees
+    );
+}
+
+TEST(TangentGraph, construct_from_world_matches_added_one_by_one) {
+    const auto world = make_world_with_trees(40);
+    const TangentGraph batched(world, 36, 400);
+    TangentGraph incremental(4000, 36, 400);
+    for (const auto& tree : world.getTrees()) {
+        incremental.add_barrier(tree.getId(), Circle(Point(tree.getX(), tree.getY()), tree.getRadius()));
+    }
+    EXPECT_EQ(batched.barriers_count(), 40u);
+    ASSERT_EQ(batched.nodes_count(), incremental.nodes_count());
+    for (std::size_t node = 0; node < batched.nodes_count(); ++node) {
+        ASSERT_EQ(batched.edges()[node].size(), incremental.edges()[node].size()) << node;
+        for (std::size_t edge = 0; edge < batched.edges()[node].size(); ++edge) {
+            EXPECT_EQ(batched.edges()[node][edge].node, incremental.edges()[node][edge].node) << node;
+        }
+    }
+}
+
+TEST(TangentGraph, update_adds_limited_number_of_barriers_per_call) {
+    const auto world = make_world_with_trees(40);
+    FullCache cache;
+    update_cache(cache, world);
+    TangentGraph graph(4000, 36, 400);
+    graph.update(cache);
+    EXPECT_EQ(graph.barriers_count(), TANGENT_GRAPH_MAX_NEW_BARRIERS_PER_UPDATE);
+    graph.update(cache);
+    EXPECT_EQ(graph.barriers_count(), 40u);
+    for (std::size_t node = 0; node < graph.nodes_count(); ++node) {
+        for (const auto& edge : graph.edges()[node]) {
+            const auto& reverse = graph.edges()[edge.node];
+            EXPECT_TRUE(std::any_of(reverse.begin(), reverse.end(),
+                [&] (const auto& v) { return v.node == node; }));
+        }
+    }
+}
+
+} // namespace tests
+} // namespace strategy
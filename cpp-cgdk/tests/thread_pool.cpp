@@ -0,0 +1,43 @@
+#include <thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace strategy {
+namespace tests {
+
+using namespace testing;
+
+TEST(ThreadPool, submit_returns_results) {
+    ThreadPool pool(2);
+    EXPECT_EQ(pool.size(), 2u);
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 10; ++i) {
+        results.push_back(pool.submit([i] { return i * i; }));
+    }
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(results[i].get(), i * i);
+    }
+}
+
+TEST(ThreadPool, submit_passes_exception_to_future) {
+    ThreadPool pool(1);
+    auto result = pool.submit([] () -> int { throw std::runtime_error("error"); });
+    EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+TEST(ThreadPool, destructor_completes_submitted_tasks) {
+    std::vector<int> values(100, 0);
+    {
+        ThreadPool pool(3);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            pool.submit([&, i] { values[i] = 1; });
+        }
+    }
+    EXPECT_EQ(std::count(values.begin(), values.end(), 1), 100);
+}
+
+} // namespace tests
+} // namespace strategy
@@ -0,0 +1,45 @@
+#include "thread_pool.hpp"
+
+namespace strategy {
+
+ThreadPool::ThreadPool(std::size_t workers_count) {
+    workers_.reserve(workers_count);
+    for (std::size_t i = 0; i < workers_count; ++i) {
+        workers_.emplace_back([this] { this->run(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        done_ = true;
+    }
+
+    has_tasks_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::run() {
+    while (true) {
+        std::function<void ()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            has_tasks_.wait(lock, [&] { return done_ || !tasks_.empty(); });
+
+            if (tasks_.empty()) {
+                return;
+            }
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        task();
+    }
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace strategy {
+
+class ThreadPool {
+public:
+    ThreadPool(std::size_t workers_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator =(const ThreadPool&) = delete;
+
+    std::size_t size() const {
+        return workers_.size();
+    }
+
+    template <class Function>
+    std::future<typename std::result_of<Function ()>::type> submit(Function&& function) {
+        using Result = typename std::result_of<Function ()>::type;
+
+        const auto task = std::make_shared<std::packaged_task<Result ()>>(std::forward<Function>(function));
+        auto result = task->get_future();
+
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.emplace_back([task] { (*task)(); });
+        }
+
+        has_tasks_.notify_one();
+
+        return result;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable has_tasks_;
+    std::deque<std::function<void ()>> tasks_;
+    bool done_ = false;
+    std::vector<std::thread> workers_;
+
+    void run();
+};
+
+}
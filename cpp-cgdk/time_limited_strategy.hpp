@@ -21,13 +21,14 @@ public:
 
     void apply(Context& context) override final;
 
+    static int get_base_time_limit_per_tick(bool is_master);
+
 private:
     std::unique_ptr<AbstractStrategy> base_;
     Duration sum_time_;
 
     Duration get_iteration_time_limit(const Context& context) const;
     Duration get_full_time_limit(int tick, bool is_master) const;
-    static int get_base_time_limit_per_tick(bool is_master);
 };
 
 }
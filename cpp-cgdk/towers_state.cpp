@@ -0,0 +1,99 @@
+#include "towers_state.hpp"
+#include "helpers.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace strategy {
+
+TowersOrder::TowersOrder(const model::World& world, model::Faction faction)
+    : faction_(faction),
+      friend_towers_({{
+        {{Point(1370.66, 3650),
+          Point(2312.13, 3950)}}, // TOP
+        {{Point(902.613, 2768.1),
+          Point(1929.29, 2400)}}, // MIDDLE
+        {{Point(50, 2693.26),
+          Point(350, 1656.75)}}, // BOTTOM
+      }}),
+      enemy_towers_({{
+        {{Point(world.getWidth() - 1370.66, world.getHeight() - 3650),
+          Point(world.getWidth() - 2312.13, world.getHeight() - 3950)}}, // TOP
+        {{Point(world.getWidth() - 902.613, world.getHeight() - 2768.1),
+          Point(world.getWidth() - 1929.29, world.getHeight() - 2400)}}, // MIDDLE
+        {{Point(world.getWidth() - 50, world.getHeight() - 2693.26),
+          Point(world.getWidth() - 350, world.getHeight() - 1656.75)}}, // BOTTOM
+      }}) {
+}
+
+model::LaneType TowersOrder::get_lane(const model::Building& unit) const {
+    if (unit.getFaction() == faction_) {
+        return get_lane(unit, friend_towers_);
+    } else {
+        return get_lane(unit, enemy_towers_);
+    }
+}
+
+TowerNumber TowersOrder::get_number(const model::Building& unit) const {
+    const auto lane = get_lane(unit);
+    if (unit.getFaction() == faction_) {
+        return get_number(unit, friend_towers_[lane]);
+    } else {
+        return get_number(unit, enemy_towers_[lane]);
+    }
+}
+
+const Point& TowersOrder::get_enemy_tower(model::LaneType lane, TowerNumber number) const {
+    return enemy_towers_[lane][std::size_t(number)];
+}
+
+model::LaneType TowersOrder::get_lane(const model::Building& unit, const std::array<std::array<Point, 2>, 3>& towers) const {
+    const auto lane = std::find_if(towers.begin(), towers.end(),
+        [&] (const auto& v) { return this->get_number(unit, v) != TowerNumber::UNKNOWN; });
+    if (lane == towers.end()) {
+        std::ostringstream error;
+        error << "Lane not found for tower with id " << unit.getId()
+              << " in " << __PRETTY_FUNCTION__ << " at " << __FILE__ << ":" << __LINE__;
+        throw std::logic_error(error.str());
+    }
+    return model::LaneType(lane - towers.begin());
+}
+
+TowerNumber TowersOrder::get_number(const model::Building& unit, const std::array<Point, 2>& towers) const {
+    const auto number = std::find_if(towers.begin(), towers.end(),
+        [&] (const auto& v) { return get_position(unit).distance(v) < 100; });
+    return number == towers.end() ? TowerNumber::UNKNOWN : TowerNumber(number - towers.begin());
+}
+
+TowersState::TowersState(const model::World& world, model::Faction faction, const FullCache& cache)
+        : order_(world, faction) {
+    const auto& buildings = get_units<model::Building>(cache);
+    const auto lanes = {model::LANE_TOP, model::LANE_MIDDLE, model::LANE_BOTTOM};
+    const auto numbers = {TowerNumber::FIRST, TowerNumber::SECOND};
+    for (const auto lane : lanes) {
+        for (const auto number : numbers) {
+            const auto& position = order_.get_enemy_tower(lane, number);
+            enemy_towers_exist_[lane][std::size_t(number)] = buildings.end() != std::find_if(buildings.begin(), buildings.end(),
+                [&] (const auto& v) { return get_position(v.second.value()).distance(position) < 100; });
+        }
+    }
+}
+
+bool TowersState::is_immortal(const model::Building& unit) const {
+    if (unit.getType() == model::BUILDING_FACTION_BASE) {
+        const auto lanes = {model::LANE_TOP, model::LANE_MIDDLE, model::LANE_BOTTOM};
+        return lanes.end() == std::find_if_not(lanes.begin(), lanes.end(),
+            [&] (auto lane) { return this->is_enemy_tower_exists(lane, TowerNumber::FIRST); });
+    }
+
+    const auto lane = order_.get_lane(unit);
+
+    if (get_position(unit).distance(order_.get_enemy_tower(lane, TowerNumber::SECOND)) < 100) {
+        return false;
+    }
+
+    return is_enemy_tower_exists(lane, TowerNumber::SECOND);
+}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "point.hpp"
+#include "cache.hpp"
+
+#include "model/Building.h"
+#include "model/LaneType.h"
+#include "model/World.h"
+
+#include <array>
+
+namespace strategy {
+
+enum class TowerNumber {
+    FIRST,
+    SECOND,
+    UNKNOWN,
+};
+
+class TowersOrder {
+public:
+    TowersOrder(const model::World& world, model::Faction faction);
+
+    model::LaneType get_lane(const model::Building& unit) const;
+    TowerNumber get_number(const model::Building& unit) const;
+    const Point& get_enemy_tower(model::LaneType lane, TowerNumber number) const;
+
+private:
+    model::Faction faction_;
+    std::array<std::array<Point, 2>, 3> friend_towers_;
+    std::array<std::array<Point, 2>, 3> enemy_towers_;
+
+    model::LaneType get_lane(const model::Building& unit, const std::array<std::array<Point, 2>, 3>& towers) const;
+    TowerNumber get_number(const model::Building& unit, const std::array<Point, 2>& towers) const;
+};
+
+class TowersState {
+public:
+    TowersState(const model::World& world, model::Faction faction, const FullCache& cache);
+
+    const TowersOrder& order() const {
+        return order_;
+    }
+
+    bool is_enemy_tower_exists(model::LaneType lane, TowerNumber number) const {
+        return enemy_towers_exist_[lane][std::size_t(number)];
+    }
+
+    bool is_immortal(const model::Building& unit) const;
+
+private:
+    TowersOrder order_;
+    std::array<std::array<bool, 2>, 3> enemy_towers_exist_;
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <sstream>
 
 #ifdef ELSID_STRATEGY_DEBUG
@@ -14,11 +15,10 @@
 
 namespace strategy {
 
-WorldGraph::WorldGraph(const model::Game& game) : graph_(0) {
-    const auto map_size = game.getMapSize();
-    const auto resolution = map_size / 10;
+WorldGraph::WorldGraph(const model::Game& game) : graph_(0), tile_size_(game.getMapSize() / 10), tiles_(10) {
+    const auto resolution = tile_size_;
     const auto half = resolution / 2;
-    const std::size_t tiles = map_size / resolution;
+    const std::size_t tiles = tiles_;
     std::vector<NodeId> nodes(tiles * tiles, std::numeric_limits<NodeId>::max());
 
     const auto get_tile_point = [&] (std::size_t x, std::size_t y) {
@@ -33,7 +33,7 @@ WorldGraph::WorldGraph(const model::Game& game) : graph_(0) {
             lanes_nodes_[lane].insert(id);
         }
 
-        nodes_.emplace(id, Node {id, get_tile_point(x, y), lane});
+        nodes_.push_back(Node {id, get_tile_point(x, y), lane});
     };
 
     const auto get_node_id = [&] (std::size_t x, std::size_t y) {
@@ -121,16 +121,83 @@ WorldGraph::WorldGraph(const model::Game& game) : graph_(0) {
     add_edge(tiles / 2, tiles / 2, tiles / 2 - 1, tiles / 2);
     add_edge(tiles / 2 - 1, tiles / 2, tiles / 2 - 1, tiles / 2 - 1);
 
+    graph_.build();
+
     center_ = get_node_id(tiles / 2 - 1, tiles / 2);
     friend_base_ = get_node_id(0, tiles - 1);
     enemy_base_ = get_node_id(tiles - 1, 0);
+
+    shortest_paths_.reserve(nodes_.size());
+    for (NodeId src = 0; src < nodes_.size(); ++src) {
+        shortest_paths_.push_back(graph_.get_shortest_paths(src));
+    }
+
+    tiles_node_.resize(nodes.size());
+    std::transform(nodes.begin(), nodes.end(), tiles_node_.begin(),
+        [&] (auto id) { return id == std::numeric_limits<NodeId>::max() ? NodeId(nodes_.size()) : id; });
+
+    build_tiles_nodes();
+}
+
+const WorldGraph::Node& WorldGraph::get_nearest_node(const Point& position) const {
+    const auto tile = get_tile(position.x()) + tiles_ * get_tile(position.y());
+    const auto begin = tiles_nodes_.begin() + std::ptrdiff_t(tiles_offsets_[tile]);
+    const auto end = tiles_nodes_.begin() + std::ptrdiff_t(tiles_offsets_[tile + 1]);
+    const auto nearest = std::min_element(begin, end, [&] (auto lhs, auto rhs) {
+        return position.distance(nodes_[lhs].position) < position.distance(nodes_[rhs].position);
+    });
+    return nodes_[*nearest];
+}
+
+std::size_t WorldGraph::get_tile(double value) const {
+    return std::size_t(std::min(double(tiles_ - 1), std::max(0.0, std::floor(value / tile_size_))));
+}
+
+void WorldGraph::build_tiles_nodes() {
+    tiles_offsets_.assign(tiles_ * tiles_ + 1, 0);
+    tiles_nodes_.clear();
+    for (std::size_t y = 0; y < tiles_; ++y) {
+        for (std::size_t x = 0; x < tiles_; ++x) {
+            const Point min(x * tile_size_, y * tile_size_);
+            const Point max((x + 1) * tile_size_, (y + 1) * tile_size_);
+            const auto get_min_distance = [&] (const Point& position) {
+                return Point(std::max(0.0, std::max(min.x() - position.x(), position.x() - max.x())),
+                             std::max(0.0, std::max(min.y() - position.y(), position.y() - max.y()))).norm();
+            };
+            const auto get_max_distance = [&] (const Point& position) {
+                return Point(std::max(std::abs(min.x() - position.x()), std::abs(max.x() - position.x())),
+                             std::max(std::abs(min.y() - position.y()), std::abs(max.y() - position.y()))).norm();
+            };
+            const auto farthest_nearest = get_max_distance(std::min_element(nodes_.begin(), nodes_.end(),
+                [&] (const auto& lhs, const auto& rhs) {
+                    return get_max_distance(lhs.position) < get_max_distance(rhs.position);
+                })->position);
+            for (const auto& node : nodes_) {
+                if (get_min_distance(node.position) <= farthest_nearest) {
+                    tiles_nodes_.push_back(node.id);
+                }
+            }
+            tiles_offsets_[x + y * tiles_ + 1] = tiles_nodes_.size();
+        }
+    }
 }
 
 WorldGraph::Path WorldGraph::get_shortest_path(NodeId src, NodeId dst) const {
-    const auto path = graph_.get_shortest_path(src, dst);
+    return get_path(shortest_paths_.at(src).path(dst));
+}
+
+double WorldGraph::get_shortest_path_length(NodeId src, NodeId dst) const {
+    return shortest_paths_.at(src).length(dst);
+}
+
+WorldGraph::ShortestPathTree WorldGraph::get_shortest_paths(NodeId src) const {
+    return ShortestPathTree(*this, shortest_paths_.at(src));
+}
+
+WorldGraph::Path WorldGraph::get_path(const Graph::Path& path) const {
     WorldGraph::Path result {path.length, {}};
     result.nodes.reserve(path.nodes.size());
-    std::transform(path.nodes.begin(), path.nodes.end(), std::back_inserter(result.nodes), [&] (auto id) { return this->nodes().at(id); });
+    std::transform(path.nodes.begin(), path.nodes.end(), std::back_inserter(result.nodes), [&] (auto id) { return nodes_[id]; });
     return result;
 }
 
@@ -143,15 +210,14 @@ std::string render(const WorldGraph& world_graph, double map_size) {
 
     const auto& nodes = world_graph.nodes();
     const auto min_x = std::min_element(nodes.begin(), nodes.end(),
-        [&] (const auto& lhs, const auto& rhs) { return lhs.second.position.x() < rhs.second.position.x(); })->second.position.x();
+        [&] (const auto& lhs, const auto& rhs) { return lhs.position.x() < rhs.position.x(); })->position.x();
     const auto min_y = std::min_element(nodes.begin(), nodes.end(),
-        [&] (const auto& lhs, const auto& rhs) { return lhs.second.position.y() < rhs.second.position.y(); })->second.position.y();
+        [&] (const auto& lhs, const auto& rhs) { return lhs.position.y() < rhs.position.y(); })->position.y();
 
-    for (const auto& v : nodes) {
-        const auto& node = v.second;
+    for (const auto& node : nodes) {
         const std::size_t x = std::max(0, int(std::round((node.position.x() - min_x) * width / map_size)));
         const std::size_t y = std::max(0, int(std::round((node.position.y() - min_y) * height / map_size)));
-        auto label = std::to_string(v.first);
+        auto label = std::to_string(node.id);
 
         switch (node.lane) {
             case model::LANE_TOP:
@@ -10,6 +10,7 @@
 #include <unordered_map>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace strategy {
 
@@ -23,7 +24,7 @@ public:
         model::LaneType lane;
     };
 
-    using Nodes = std::map<NodeId, Node>;
+    using Nodes = std::vector<Node>;
     using LanesNodes = std::unordered_map<model::LaneType, std::set<NodeId>>;
 
     struct Path {
@@ -31,8 +32,23 @@ public:
         std::vector<Node> nodes;
     };
 
+    class ShortestPathTree {
+    public:
+        ShortestPathTree(const WorldGraph& world_graph, const Graph::ShortestPathTree& tree)
+            : world_graph_(world_graph), tree_(tree) {}
+
+        double length(NodeId dst) const { return tree_.length(dst); }
+        std::size_t nodes_count(NodeId dst) const { return tree_.nodes_count(dst); }
+        Path path(NodeId dst) const { return world_graph_.get_path(tree_.path(dst)); }
+
+    private:
+        const WorldGraph& world_graph_;
+        const Graph::ShortestPathTree& tree_;
+    };
+
     WorldGraph(const model::Game& game);
 
+    const Graph& graph() const { return graph_; }
     const Nodes& nodes() const { return nodes_; }
     const Matrix& arcs() const { return graph_.arcs(); }
     const LanesNodes& lanes_nodes() const { return lanes_nodes_; }
@@ -40,7 +56,27 @@ public:
     NodeId friend_base() const { return friend_base_; }
     NodeId enemy_base() const { return enemy_base_; }
 
+    const Node& get_nearest_node(const Point& position) const;
+
+    template <class Function>
+    void for_each_node(const Point& position, double radius, const Function& function) const {
+        const auto begin_x = get_tile(position.x() - radius);
+        const auto end_x = get_tile(position.x() + radius);
+        const auto begin_y = get_tile(position.y() - radius);
+        const auto end_y = get_tile(position.y() + radius);
+        for (auto y = begin_y; y <= end_y; ++y) {
+            for (auto x = begin_x; x <= end_x; ++x) {
+                const auto node = tiles_node_[x + y * tiles_];
+                if (node != nodes_.size()) {
+                    function(nodes_[node]);
+                }
+            }
+        }
+    }
+
     Path get_shortest_path(NodeId src, NodeId dst) const;
+    double get_shortest_path_length(NodeId src, NodeId dst) const;
+    ShortestPathTree get_shortest_paths(NodeId src) const;
 
 private:
     Graph graph_;
@@ -49,6 +85,17 @@ private:
     NodeId center_;
     NodeId friend_base_;
     NodeId enemy_base_;
+    std::vector<Graph::ShortestPathTree> shortest_paths_;
+    double tile_size_;
+    std::size_t tiles_;
+    std::vector<std::size_t> tiles_offsets_;
+    std::vector<NodeId> tiles_nodes_;
+    std::vector<NodeId> tiles_node_;
+
+    std::size_t get_tile(double value) const;
+    void build_tiles_nodes();
+
+    Path get_path(const Graph::Path& path) const;
 };
 
 std::string render(const WorldGraph& world_graph, double map_size);
@@ -14,21 +14,31 @@ cp action.cpp ${DIR}
 cp base_strategy.cpp ${DIR}
 cp battle_mode.cpp ${DIR}
 cp circle.cpp ${DIR}
+cp circles_grid.cpp ${DIR}
+cp dynamic_shortest_paths.cpp ${DIR}
+cp flow_field.cpp ${DIR}
 cp graph.cpp ${DIR}
 cp master_strategy.cpp ${DIR}
 cp move_mode.cpp ${DIR}
 cp move_to_node.cpp ${DIR}
 cp move_to_position.cpp ${DIR}
+cp moving_circles.cpp ${DIR}
 cp MyStrategy.cpp ${DIR}
 cp optimal_destination.cpp ${DIR}
 cp optimal_movement.cpp ${DIR}
 cp optimal_path.cpp ${DIR}
 cp optimal_position.cpp ${DIR}
 cp optimal_target.cpp ${DIR}
+cp position_penalty_kernels.cpp ${DIR}
+cp position_warm_starts.cpp ${DIR}
+cp reach_time.cpp ${DIR}
 cp retreat_mode.cpp ${DIR}
+cp safe_paths.cpp ${DIR}
 cp skills.cpp ${DIR}
 cp stats.cpp ${DIR}
+cp tangent_graph.cpp ${DIR}
 cp time_limited_strategy.cpp ${DIR}
+cp towers_state.cpp ${DIR}
 cp world_graph.cpp ${DIR}
 
 cp abstract_strategy.hpp ${DIR}
@@ -37,12 +47,18 @@ cp base_strategy.hpp ${DIR}
 cp battle_mode.hpp ${DIR}
 cp cache.hpp ${DIR}
 cp circle.hpp ${DIR}
+cp circles_grid.hpp ${DIR}
 cp common.hpp ${DIR}
 cp context.hpp ${DIR}
+cp corridor.hpp ${DIR}
 cp damage.hpp ${DIR}
+cp dynamic_shortest_paths.hpp ${DIR}
+cp flat_hash_map.hpp ${DIR}
+cp flow_field.hpp ${DIR}
 cp golden_section.hpp ${DIR}
 cp graph.hpp ${DIR}
 cp helpers.hpp ${DIR}
+cp indexed_heap.hpp ${DIR}
 cp line.hpp ${DIR}
 cp master_strategy.hpp ${DIR}
 cp math.hpp ${DIR}
@@ -51,6 +67,7 @@ cp mode.hpp ${DIR}
 cp move_mode.hpp ${DIR}
 cp move_to_node.hpp ${DIR}
 cp move_to_position.hpp ${DIR}
+cp moving_circles.hpp ${DIR}
 cp MyStrategy.h ${DIR}
 cp optimal_destination.hpp ${DIR}
 cp optimal_movement.hpp ${DIR}
@@ -58,12 +75,19 @@ cp optimal_path.hpp ${DIR}
 cp optimal_position.hpp ${DIR}
 cp optimal_target.hpp ${DIR}
 cp point.hpp ${DIR}
+cp position_penalty_kernels.hpp ${DIR}
+cp position_warm_starts.hpp ${DIR}
 cp profiler.hpp ${DIR}
+cp reach_time.hpp ${DIR}
 cp retreat_mode.hpp ${DIR}
+cp safe_paths.hpp ${DIR}
+cp simd.hpp ${DIR}
 cp skills.hpp ${DIR}
 cp stats.hpp ${DIR}
+cp tangent_graph.hpp ${DIR}
 cp target.hpp ${DIR}
 cp time_limited_strategy.hpp ${DIR}
+cp towers_state.hpp ${DIR}
 cp world_graph.hpp ${DIR}
 
 cd ../bobyqa-cpp/